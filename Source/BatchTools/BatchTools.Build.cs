@@ -33,7 +33,12 @@ public class BatchTools : ModuleRules
             "SourceControl",
             "ToolWidgets",
             "WorkspaceMenuStructure",
-            "AssetRegistry"
+            "AssetRegistry",
+            "Json",
+            "TargetPlatform",
+            "Projects",
+            "ImageCore",
+            "AudioPlatformConfiguration"
         });
     }
 }
\ No newline at end of file
@@ -0,0 +1,376 @@
+#include "BatchToolsAtlasBuilder.h"
+#include "BatchToolsModule.h"
+#include "BatchToolsTextureIndex.h"
+#include "Engine/Texture2D.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "Async/ParallelFor.h"
+#include "ImageCore.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "PixelFormat.h"
+
+namespace BatchToolsAtlasBuilder
+{
+    static EPixelFormat GetPlatformFormat(const UTexture2D* Texture)
+    {
+        const FTexturePlatformData* PlatformData = Texture->GetPlatformData();
+        return PlatformData ? PlatformData->PixelFormat : PF_Unknown;
+    }
+}
+
+bool UBatchToolsAtlasLookup::FindSprite(const TSoftObjectPtr<UTexture2D>& SourceTexture, FBatchToolsAtlasSprite& OutSprite) const
+{
+    if (const FBatchToolsAtlasSprite* Sprite = Sprites.Find(SourceTexture.ToSoftObjectPath()))
+    {
+        OutSprite = *Sprite;
+        return true;
+    }
+    return false;
+}
+
+FBatchToolsAtlasSettings FBatchToolsAtlasSettings::Load()
+{
+    const TCHAR* Section = TEXT("BatchTools.Atlas");
+    const FString& ConfigFilename = FBatchToolsModule::GetConfigFilename();
+
+    FBatchToolsAtlasSettings Settings;
+    GConfig->GetInt(Section, TEXT("MaxSourceSize"), Settings.MaxSourceSize, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MaxSpriteSize"), Settings.MaxSpriteSize, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("AtlasSize"), Settings.AtlasSize, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("Padding"), Settings.Padding, ConfigFilename);
+    GConfig->GetString(Section, TEXT("OutputFolder"), Settings.OutputFolder, ConfigFilename);
+
+    Settings.AtlasSize = FMath::RoundUpToPowerOfTwo(FMath::Clamp(Settings.AtlasSize, 64, 8192));
+    Settings.Padding = FMath::Clamp(Settings.Padding, 0, 16);
+    Settings.MaxSpriteSize = FMath::Clamp(Settings.MaxSpriteSize, 1, Settings.AtlasSize - Settings.Padding * 2);
+    Settings.OutputFolder.RemoveFromEnd(TEXT("/"));
+    return Settings;
+}
+
+FBatchToolsSkylinePacker::FBatchToolsSkylinePacker(int32 InWidth, int32 InHeight)
+    : Width(InWidth)
+    , Height(InHeight)
+{
+    Skyline.Add({ 0, 0, Width });
+}
+
+int32 FBatchToolsSkylinePacker::FitAt(int32 Index, int32 RectWidth, int32 RectHeight) const
+{
+    if (Skyline[Index].X + RectWidth > Width)
+        return INDEX_NONE;
+
+    int32 Y = 0;
+    int32 RemainingWidth = RectWidth;
+    for (int32 SegmentIndex = Index; RemainingWidth > 0; SegmentIndex++)
+    {
+        Y = FMath::Max(Y, Skyline[SegmentIndex].Y);
+        if (Y + RectHeight > Height)
+            return INDEX_NONE;
+        RemainingWidth -= Skyline[SegmentIndex].Width;
+    }
+    return Y;
+}
+
+bool FBatchToolsSkylinePacker::Insert(int32 RectWidth, int32 RectHeight, FIntPoint& OutPosition)
+{
+    int32 BestIndex = INDEX_NONE;
+    int32 BestTop = MAX_int32;
+    int32 BestWidth = MAX_int32;
+
+    for (int32 Index = 0; Index < Skyline.Num(); Index++)
+    {
+        const int32 Y = FitAt(Index, RectWidth, RectHeight);
+        if (Y == INDEX_NONE)
+            continue;
+
+        // Lowest top edge first, then the narrowest segment to limit wasted space
+        const int32 Top = Y + RectHeight;
+        if (Top < BestTop || (Top == BestTop && Skyline[Index].Width < BestWidth))
+        {
+            BestIndex = Index;
+            BestTop = Top;
+            BestWidth = Skyline[Index].Width;
+        }
+    }
+
+    if (BestIndex == INDEX_NONE)
+        return false;
+
+    OutPosition = FIntPoint(Skyline[BestIndex].X, BestTop - RectHeight);
+    Skyline.Insert({ OutPosition.X, BestTop, RectWidth }, BestIndex);
+
+    // Trim the segments now covered by the new one
+    for (int32 Index = BestIndex + 1; Index < Skyline.Num(); )
+    {
+        const FSegment& Previous = Skyline[Index - 1];
+        FSegment& Segment = Skyline[Index];
+        const int32 Overlap = Previous.X + Previous.Width - Segment.X;
+        if (Overlap <= 0)
+            break;
+
+        Segment.X += Overlap;
+        Segment.Width -= Overlap;
+        if (Segment.Width > 0)
+            break;
+        Skyline.RemoveAt(Index);
+    }
+
+    for (int32 Index = 0; Index + 1 < Skyline.Num(); )
+    {
+        if (Skyline[Index].Y == Skyline[Index + 1].Y)
+        {
+            Skyline[Index].Width += Skyline[Index + 1].Width;
+            Skyline.RemoveAt(Index + 1);
+        }
+        else
+        {
+            Index++;
+        }
+    }
+
+    UsedWidth = FMath::Max(UsedWidth, OutPosition.X + RectWidth);
+    UsedHeight = FMath::Max(UsedHeight, BestTop);
+    return true;
+}
+
+int32 FBatchToolsAtlasBuilder::Pack(const TArray<FBatchToolsAtlasInput>& Inputs, const TArray<int32>& InputIndices, const FBatchToolsAtlasSettings& Settings, TArray<FPlacement>& OutPlacements, TArray<FIntPoint>& OutPageSizes)
+{
+    TArray<int32> SortedIndices = InputIndices;
+    int32 NumUnpacked = SortedIndices.RemoveAll([&Inputs](int32 InputIndex) { return Inputs[InputIndex].Width <= 0 || Inputs[InputIndex].Height <= 0; });
+
+    SortedIndices.Sort([&Inputs](int32 A, int32 B)
+    {
+        if (Inputs[A].Height != Inputs[B].Height)
+            return Inputs[A].Height > Inputs[B].Height;
+        return Inputs[A].Width > Inputs[B].Width;
+    });
+
+    // Small groups pack into a narrower page, so the skyline does not spread a few sprites along the full width
+    int64 PaddedArea = 0;
+    int32 WidestSprite = 1;
+    for (int32 InputIndex : SortedIndices)
+    {
+        const int32 PaddedWidth = Inputs[InputIndex].Width + Settings.Padding * 2;
+        PaddedArea += (int64)PaddedWidth * (Inputs[InputIndex].Height + Settings.Padding * 2);
+        WidestSprite = FMath::Max(WidestSprite, PaddedWidth);
+    }
+    const int32 SquareSide = FMath::CeilToInt(FMath::Sqrt((double)PaddedArea));
+    const int32 PageWidth = FMath::Min(Settings.AtlasSize, (int32)FMath::RoundUpToPowerOfTwo(FMath::Max(WidestSprite, SquareSide)));
+
+    TArray<FBatchToolsSkylinePacker> Pages;
+
+    for (int32 InputIndex : SortedIndices)
+    {
+        const int32 PaddedWidth = Inputs[InputIndex].Width + Settings.Padding * 2;
+        const int32 PaddedHeight = Inputs[InputIndex].Height + Settings.Padding * 2;
+        if (PaddedWidth > PageWidth || PaddedHeight > Settings.AtlasSize)
+        {
+            NumUnpacked++;
+            continue;
+        }
+
+        FPlacement Placement;
+        Placement.InputIndex = InputIndex;
+
+        // Earlier pages are nearly full once the large sprites are placed, so try the newest first
+        for (int32 PageIndex = Pages.Num() - 1; PageIndex >= 0; PageIndex--)
+        {
+            if (Pages[PageIndex].Insert(PaddedWidth, PaddedHeight, Placement.Position))
+            {
+                Placement.PageIndex = PageIndex;
+                break;
+            }
+        }
+
+        if (Placement.PageIndex == INDEX_NONE)
+        {
+            Placement.PageIndex = Pages.Emplace(PageWidth, Settings.AtlasSize);
+            Pages[Placement.PageIndex].Insert(PaddedWidth, PaddedHeight, Placement.Position);
+        }
+
+        OutPlacements.Add(Placement);
+    }
+
+    OutPageSizes.Reset(Pages.Num());
+    for (const FBatchToolsSkylinePacker& Page : Pages)
+    {
+        OutPageSizes.Emplace((int32)FMath::RoundUpToPowerOfTwo(FMath::Max(1, Page.GetUsedWidth())), (int32)FMath::RoundUpToPowerOfTwo(FMath::Max(1, Page.GetUsedHeight())));
+    }
+
+    return NumUnpacked;
+}
+
+UTexture2D* FBatchToolsAtlasBuilder::CreateAtlasTexture(const FString& PackageName, int32 Width, int32 Height, const TArray<FColor>& Pixels, const UTexture2D* Template, bool bNoAlpha)
+{
+    UPackage* Package = CreatePackage(*PackageName);
+    UTexture2D* Atlas = NewObject<UTexture2D>(Package, FName(*FPackageName::GetShortName(PackageName)), RF_Public | RF_Standalone);
+
+    Atlas->Source.Init(Width, Height, 1, 1, TSF_BGRA8, (const uint8*)Pixels.GetData());
+    Atlas->CompressionSettings = Template->CompressionSettings;
+    Atlas->CompressionNoAlpha = Template->CompressionNoAlpha || bNoAlpha;
+    Atlas->SRGB = Template->SRGB;
+    Atlas->LODGroup = Template->LODGroup;
+    Atlas->Filter = Template->Filter;
+    Atlas->PostEditChange();
+
+    FAssetRegistryModule::AssetCreated(Atlas);
+    Atlas->MarkPackageDirty();
+    return Atlas;
+}
+
+FBatchToolsAtlasReport FBatchToolsAtlasBuilder::Build(const TArray<FBatchToolsAtlasInput>& Inputs, const FString& OutputFolder, const FBatchToolsAtlasSettings& Settings)
+{
+    FBatchToolsAtlasReport Report;
+    IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+
+    // Sprites sharing an atlas must share its format and color space. The same compression settings
+    // still compress to different formats with and without alpha (DXT1 and DXT5), so that is part of the key.
+    TMap<FString, TArray<int32>> Groups;
+    for (int32 InputIndex = 0; InputIndex < Inputs.Num(); InputIndex++)
+    {
+        const UTexture2D* Texture = Inputs[InputIndex].Texture;
+        const FString GroupKey = FString::Printf(TEXT("%d_%d_%d_%d"), (int32)Texture->CompressionSettings, Texture->SRGB ? 1 : 0, (int32)Texture->LODGroup,
+                                                 (int32)BatchToolsAtlasBuilder::GetPlatformFormat(Texture));
+        Groups.FindOrAdd(GroupKey).Add(InputIndex);
+    }
+
+    FString LookupPackageName;
+    FString LookupAssetName;
+    AssetTools.CreateUniqueAssetName(OutputFolder / TEXT("DA_AtlasLookup"), TEXT(""), LookupPackageName, LookupAssetName);
+    UPackage* LookupPackage = CreatePackage(*LookupPackageName);
+    UBatchToolsAtlasLookup* Lookup = NewObject<UBatchToolsAtlasLookup>(LookupPackage, FName(*LookupAssetName), RF_Public | RF_Standalone);
+
+    for (const TPair<FString, TArray<int32>>& Group : Groups)
+    {
+        // A single sprite gains nothing from an atlas
+        if (Group.Value.Num() < 2)
+        {
+            Report.NumUnpacked += Group.Value.Num();
+            continue;
+        }
+
+        TArray<FPlacement> Placements;
+        TArray<FIntPoint> PageSizes;
+        const double PackStartTime = FPlatformTime::Seconds();
+        const int32 NumGroupUnpacked = Pack(Inputs, Group.Value, Settings, Placements, PageSizes);
+        Report.PackSeconds += FPlatformTime::Seconds() - PackStartTime;
+
+        const UTexture2D* Template = Inputs[Group.Value[0]].Texture;
+        const EGammaSpace GammaSpace = Template->SRGB ? EGammaSpace::sRGB : EGammaSpace::Linear;
+
+        // Every sprite in the group uses this format, and the atlas is kept in it
+        const EPixelFormat PixelFormat = BatchToolsAtlasBuilder::GetPlatformFormat(Template);
+        const FName FormatName = PixelFormat != PF_Unknown ? FName(GPixelFormats[PixelFormat].Name) : NAME_None;
+        const bool bNoAlpha = PixelFormat != PF_Unknown && GPixelFormats[PixelFormat].NumComponents < 4;
+
+        // Nothing is written for a group whose atlases would not be smaller than its sprites
+        int64 GroupBeforeBytes = 0;
+        int64 GroupAfterBytes = 0;
+        for (const FPlacement& Placement : Placements)
+            GroupBeforeBytes += Inputs[Placement.InputIndex].ResidentBytes;
+        for (const FIntPoint& PageSize : PageSizes)
+            GroupAfterBytes += FBatchToolsTextureIndex::EstimateResidentBytes(PageSize.X, PageSize.Y, FormatName, 0);
+
+        if (GroupAfterBytes >= GroupBeforeBytes)
+        {
+            UE_LOG(LogBatchTools, Log, TEXT("Skipping atlas group %s: %.2fMB of atlases would not beat %.2fMB of sprites"),
+                   *Group.Key, GroupAfterBytes / (1024.0 * 1024.0), GroupBeforeBytes / (1024.0 * 1024.0));
+            Report.NumUnpacked += Group.Value.Num();
+            continue;
+        }
+        Report.NumUnpacked += NumGroupUnpacked;
+
+        for (int32 PageIndex = 0; PageIndex < PageSizes.Num(); PageIndex++)
+        {
+            const int32 PageWidth = PageSizes[PageIndex].X;
+            const int32 PageHeight = PageSizes[PageIndex].Y;
+
+            TArray<const FPlacement*> PagePlacements;
+            for (const FPlacement& Placement : Placements)
+            {
+                if (Placement.PageIndex == PageIndex)
+                    PagePlacements.Add(&Placement);
+            }
+
+            // Bulk data reads stay on the game thread, the resample and blit run in parallel
+            TArray<FImage> SourceImages;
+            SourceImages.SetNum(PagePlacements.Num());
+            for (int32 Index = 0; Index < PagePlacements.Num(); Index++)
+            {
+                Inputs[PagePlacements[Index]->InputIndex].Texture->Source.GetMipImage(SourceImages[Index], 0);
+            }
+
+            TArray<FColor> Pixels;
+            Pixels.SetNumZeroed(PageWidth * PageHeight);
+
+            ParallelFor(PagePlacements.Num(), [&](int32 Index)
+            {
+                const FPlacement& Placement = *PagePlacements[Index];
+                const FBatchToolsAtlasInput& Input = Inputs[Placement.InputIndex];
+
+                FImage Sprite;
+                if (SourceImages[Index].SizeX == Input.Width && SourceImages[Index].SizeY == Input.Height)
+                    SourceImages[Index].CopyTo(Sprite, ERawImageFormat::BGRA8, GammaSpace);
+                else
+                    SourceImages[Index].ResizeTo(Sprite, Input.Width, Input.Height, ERawImageFormat::BGRA8, GammaSpace);
+
+                const TArrayView64<FColor> SpritePixels = Sprite.AsBGRA8();
+                const int32 PaddedWidth = Input.Width + Settings.Padding * 2;
+                const int32 PaddedHeight = Input.Height + Settings.Padding * 2;
+
+                // The padding repeats the sprite's edge pixels
+                for (int32 Y = 0; Y < PaddedHeight; Y++)
+                {
+                    const int32 SourceY = FMath::Clamp(Y - Settings.Padding, 0, Input.Height - 1);
+                    FColor* DestRow = Pixels.GetData() + (int64)(Placement.Position.Y + Y) * PageWidth + Placement.Position.X;
+                    for (int32 X = 0; X < PaddedWidth; X++)
+                    {
+                        const int32 SourceX = FMath::Clamp(X - Settings.Padding, 0, Input.Width - 1);
+                        DestRow[X] = SpritePixels[(int64)SourceY * Input.Width + SourceX];
+                    }
+                }
+            });
+            SourceImages.Empty();
+
+            FString AtlasPackageName;
+            FString AtlasAssetName;
+            AssetTools.CreateUniqueAssetName(OutputFolder / TEXT("T_Atlas"), TEXT(""), AtlasPackageName, AtlasAssetName);
+            UTexture2D* Atlas = CreateAtlasTexture(AtlasPackageName, PageWidth, PageHeight, Pixels, Template, bNoAlpha);
+            Lookup->Atlases.Add(Atlas);
+            Report.NumAtlases++;
+            Report.AfterResidentBytes += FBatchToolsTextureIndex::EstimateResidentBytes(PageWidth, PageHeight, FormatName, 0);
+
+            for (const FPlacement* Placement : PagePlacements)
+            {
+                const FBatchToolsAtlasInput& Input = Inputs[Placement->InputIndex];
+                const float MinX = (float)(Placement->Position.X + Settings.Padding);
+                const float MinY = (float)(Placement->Position.Y + Settings.Padding);
+
+                FBatchToolsAtlasSprite Sprite;
+                Sprite.SourceTexture = Input.Texture;
+                Sprite.Atlas = Atlas;
+                Sprite.UVRect = FVector4f(MinX / PageWidth, MinY / PageHeight, (MinX + Input.Width) / PageWidth, (MinY + Input.Height) / PageHeight);
+                Lookup->Sprites.Add(FSoftObjectPath(Input.Texture), Sprite);
+
+                Report.NumSprites++;
+                Report.BeforeResidentBytes += Input.ResidentBytes;
+            }
+        }
+    }
+
+    if (Report.NumAtlases > 0)
+    {
+        FAssetRegistryModule::AssetCreated(Lookup);
+        Lookup->MarkPackageDirty();
+        Report.Lookup = Lookup;
+    }
+    else
+    {
+        Lookup->ClearFlags(RF_Public | RF_Standalone);
+        Lookup->MarkAsGarbage();
+    }
+
+    return Report;
+}
@@ -0,0 +1,466 @@
+#include "BatchToolsAudioOptimizer.h"
+#include "BatchToolsModule.h"
+#include "BatchToolsPolicy.h"
+#include "Async/ParallelFor.h"
+#include "AssetCompilingManager.h"
+#include "AudioCompressionSettingsUtils.h"
+#include "Interfaces/ITargetPlatform.h"
+#include "Interfaces/ITargetPlatformManagerModule.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Sound/SoundWave.h"
+
+#define LOCTEXT_NAMESPACE "FBatchToolsModule"
+
+namespace BatchToolsAudio
+{
+    static constexpr int32 FFTSize = 2048;
+    // Waves whose PCM is held in memory at once during analysis
+    static constexpr int32 AnalysisChunkSize = 32;
+
+    // Ascending rates; the platform decides what each setting means
+    static const ESoundwaveSampleRateSettings SampleRateLadder[] =
+    {
+        ESoundwaveSampleRateSettings::Min,
+        ESoundwaveSampleRateSettings::Low,
+        ESoundwaveSampleRateSettings::Medium,
+        ESoundwaveSampleRateSettings::High,
+        ESoundwaveSampleRateSettings::Max
+    };
+
+    static float GetPlatformSampleRate(const FPlatformAudioCookOverrides* Overrides, ESoundwaveSampleRateSettings Setting)
+    {
+        if (Overrides)
+        {
+            if (const float* Rate = Overrides->PlatformSampleRates.Find(Setting))
+                return *Rate;
+        }
+
+        switch (Setting)
+        {
+            case ESoundwaveSampleRateSettings::Min:
+                return 8000.0f;
+            case ESoundwaveSampleRateSettings::Low:
+                return 12000.0f;
+            case ESoundwaveSampleRateSettings::Medium:
+                return 24000.0f;
+            case ESoundwaveSampleRateSettings::High:
+                return 32000.0f;
+            default:
+                return 48000.0f;
+        }
+    }
+
+    // In-place iterative radix-2 FFT
+    static void FFT(TArray<float>& Real, TArray<float>& Imag)
+    {
+        const int32 N = Real.Num();
+        for (int32 Index = 1, Reversed = 0; Index < N; Index++)
+        {
+            int32 Bit = N >> 1;
+            for (; Reversed & Bit; Bit >>= 1)
+                Reversed ^= Bit;
+            Reversed ^= Bit;
+            if (Index < Reversed)
+            {
+                Swap(Real[Index], Real[Reversed]);
+                Swap(Imag[Index], Imag[Reversed]);
+            }
+        }
+
+        for (int32 Length = 2; Length <= N; Length <<= 1)
+        {
+            const float Angle = -2.0f * PI / (float)Length;
+            const float StepReal = FMath::Cos(Angle);
+            const float StepImag = FMath::Sin(Angle);
+            for (int32 Start = 0; Start < N; Start += Length)
+            {
+                float WReal = 1.0f;
+                float WImag = 0.0f;
+                for (int32 Offset = 0; Offset < Length / 2; Offset++)
+                {
+                    const int32 Even = Start + Offset;
+                    const int32 Odd = Even + Length / 2;
+                    const float OddReal = Real[Odd] * WReal - Imag[Odd] * WImag;
+                    const float OddImag = Real[Odd] * WImag + Imag[Odd] * WReal;
+                    Real[Odd] = Real[Even] - OddReal;
+                    Imag[Odd] = Imag[Even] - OddImag;
+                    Real[Even] += OddReal;
+                    Imag[Even] += OddImag;
+
+                    const float NextReal = WReal * StepReal - WImag * StepImag;
+                    WImag = WReal * StepImag + WImag * StepReal;
+                    WReal = NextReal;
+                }
+            }
+        }
+    }
+}
+
+FBatchToolsAudioSettings FBatchToolsAudioSettings::Load()
+{
+    const TCHAR* Section = TEXT("BatchTools.Audio");
+    const FString& ConfigFilename = FBatchToolsModule::GetConfigFilename();
+
+    FBatchToolsAudioSettings Settings;
+    GConfig->GetFloat(Section, TEXT("BudgetMB"), Settings.BudgetMB, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MinQuality"), Settings.MinQuality, ConfigFilename);
+    GConfig->GetFloat(Section, TEXT("SpectralRolloff"), Settings.SpectralRolloff, ConfigFilename);
+    GConfig->GetFloat(Section, TEXT("MaxAnalysisSeconds"), Settings.MaxAnalysisSeconds, ConfigFilename);
+    GConfig->GetFloat(Section, TEXT("LoopQualityScale"), Settings.LoopQualityScale, ConfigFilename);
+    GConfig->GetFloat(Section, TEXT("MinDurationSeconds"), Settings.MinDurationSeconds, ConfigFilename);
+    GConfig->GetBool(Section, TEXT("bRebuildCompressedData"), Settings.bRebuildCompressedData, ConfigFilename);
+    GConfig->GetFloat(Section, TEXT("RebuildTimeoutSeconds"), Settings.RebuildTimeoutSeconds, ConfigFilename);
+
+    Settings.BudgetMB = FMath::Max(0.0f, Settings.BudgetMB);
+    Settings.MinQuality = FMath::Clamp(Settings.MinQuality, 1, 100);
+    Settings.SpectralRolloff = FMath::Clamp(Settings.SpectralRolloff, 0.5f, 1.0f);
+    Settings.MaxAnalysisSeconds = FMath::Max(1.0f, Settings.MaxAnalysisSeconds);
+    Settings.LoopQualityScale = FMath::Clamp(Settings.LoopQualityScale, 0.1f, 1.0f);
+    Settings.MinDurationSeconds = FMath::Max(0.0f, Settings.MinDurationSeconds);
+    Settings.RebuildTimeoutSeconds = FMath::Max(0.0f, Settings.RebuildTimeoutSeconds);
+    return Settings;
+}
+
+float FBatchToolsAudioOptimizer::AnalyzeBandwidth(const int16* Samples, int32 NumFrames, int32 NumChannels, int32 SampleRate, float Rolloff, float MaxSeconds)
+{
+    using namespace BatchToolsAudio;
+
+    const float Nyquist = SampleRate * 0.5f;
+    if (NumFrames < FFTSize || NumChannels <= 0 || SampleRate <= 0)
+        return Nyquist;
+
+    // Evenly spaced windows so long waves cost the same as MaxSeconds of audio
+    const int32 MaxWindows = FMath::Max(1, FMath::CeilToInt(MaxSeconds * SampleRate / FFTSize));
+    const int32 NumWindows = FMath::Min(MaxWindows, NumFrames / FFTSize);
+    const int64 WindowStride = (int64)(NumFrames - FFTSize) / FMath::Max(1, NumWindows - 1);
+
+    TArray<float> Real;
+    TArray<float> Imag;
+    TArray<double> Power;
+    Real.SetNumUninitialized(FFTSize);
+    Imag.SetNumUninitialized(FFTSize);
+    Power.SetNumZeroed(FFTSize / 2);
+
+    const float Scale = 1.0f / (32768.0f * NumChannels);
+    for (int32 Window = 0; Window < NumWindows; Window++)
+    {
+        const int16* Frame = Samples + Window * WindowStride * NumChannels;
+        for (int32 Index = 0; Index < FFTSize; Index++)
+        {
+            int32 Sum = 0;
+            for (int32 Channel = 0; Channel < NumChannels; Channel++)
+                Sum += Frame[Index * NumChannels + Channel];
+
+            // Hann window against leakage from the window edges into high bins
+            const float Hann = 0.5f - 0.5f * FMath::Cos(2.0f * PI * Index / (FFTSize - 1));
+            Real[Index] = Sum * Scale * Hann;
+            Imag[Index] = 0.0f;
+        }
+
+        BatchToolsAudio::FFT(Real, Imag);
+        for (int32 Bin = 1; Bin < FFTSize / 2; Bin++)
+            Power[Bin] += (double)Real[Bin] * Real[Bin] + (double)Imag[Bin] * Imag[Bin];
+    }
+
+    double TotalPower = 0.0;
+    for (double BinPower : Power)
+        TotalPower += BinPower;
+    if (TotalPower <= UE_DOUBLE_SMALL_NUMBER)
+        return 0.0f;
+
+    double Cumulative = 0.0;
+    for (int32 Bin = 1; Bin < FFTSize / 2; Bin++)
+    {
+        Cumulative += Power[Bin];
+        if (Cumulative >= TotalPower * Rolloff)
+            return (float)(Bin + 1) * SampleRate / FFTSize;
+    }
+    return Nyquist;
+}
+
+int64 FBatchToolsAudioOptimizer::EstimateCompressedBytes(float DurationSeconds, int32 NumChannels, float SampleRate, int32 Quality)
+{
+    // About 96 kbps per channel at quality 40 and 48 kHz, 192 kbps at quality 100
+    const double BitsPerSecond = (32000.0 + 1600.0 * Quality) * (SampleRate / 48000.0) * NumChannels;
+    return (int64)(BitsPerSecond * DurationSeconds / 8.0);
+}
+
+FTextureOptimizationResultTable FBatchToolsAudioOptimizer::Run(const TArray<FAssetData>& SoundWaves, const FBatchToolsAudioSettings& Settings)
+{
+    using namespace BatchToolsAudio;
+
+    FTextureOptimizationResultTable Results;
+    if (SoundWaves.Num() == 0)
+        return Results;
+
+    FScopedSlowTask SlowTask((float)SoundWaves.Num() + 2.0f, LOCTEXT("OptimizingSounds", "Optimizing Sound Waves..."));
+    SlowTask.MakeDialog(true);
+
+    const FPlatformAudioCookOverrides* CookOverrides = FPlatformCompressionUtilities::GetCookOverrides();
+    const bool bCanResample = !CookOverrides || CookOverrides->bResampleForDevice;
+    if (!bCanResample)
+    {
+        UE_LOG(LogBatchTools, Warning, TEXT("Resampling is disabled for the running platform; sample rates are left unchanged"));
+    }
+
+    struct FWaveInfo
+    {
+        USoundWave* Wave = nullptr;
+        float Duration = 0.0f;
+        int32 NumChannels = 0;
+        float ImportedRate = 0.0f;
+        float BandwidthHz = 0.0f;
+        ESoundwaveSampleRateSettings NewSampleRate = ESoundwaveSampleRateSettings::Max;
+        int32 NewQuality = 0;
+        TArray<uint8> PCM;
+    };
+
+    const TArray<FTexturePolicyDecision> Decisions = FBatchToolsPolicy::Get().EvaluateBatch(SoundWaves);
+
+    TArray<FTextureOptimizationResult> Rows;
+    TArray<FWaveInfo> Waves;
+    Rows.SetNum(SoundWaves.Num());
+    Waves.SetNum(SoundWaves.Num());
+
+    // Without resampling every setting plays back at the imported rate
+    auto GetEffectiveRate = [CookOverrides, bCanResample](const FWaveInfo& Info, ESoundwaveSampleRateSettings Setting)
+    {
+        return bCanResample ? FMath::Min(Info.ImportedRate, GetPlatformSampleRate(CookOverrides, Setting)) : Info.ImportedRate;
+    };
+
+    // PCM is read on the game thread a chunk at a time and analyzed on worker threads
+    bool bCancelled = false;
+    for (int32 ChunkStart = 0; ChunkStart < SoundWaves.Num(); ChunkStart += AnalysisChunkSize)
+    {
+        const int32 ChunkEnd = FMath::Min(ChunkStart + AnalysisChunkSize, SoundWaves.Num());
+        for (int32 Index = ChunkStart; Index < ChunkEnd; Index++)
+        {
+            SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("AnalyzingSound", "Analyzing {0}..."), FText::FromName(SoundWaves[Index].AssetName)));
+
+            FTextureOptimizationResult& Row = Rows[Index];
+            Row.TextureName = SoundWaves[Index].AssetName;
+            Row.PackageName = SoundWaves[Index].PackageName;
+            Row.AssetKind = EBatchAssetKind::SoundWave;
+            Row.MethodUsed = EOptimizationMethod::AudioCompression;
+
+            if (bCancelled || SlowTask.ShouldCancel())
+            {
+                bCancelled = true;
+                Row.Error = EOptimizationError::Cancelled;
+                continue;
+            }
+            if (Decisions[Index].bSkip)
+            {
+                Row.Error = EOptimizationError::SkippedByPolicy;
+                continue;
+            }
+
+            USoundWave* Wave = Cast<USoundWave>(SoundWaves[Index].GetAsset());
+            if (!Wave)
+            {
+                Row.Error = EOptimizationError::LoadFailed;
+                continue;
+            }
+
+            FWaveInfo& Info = Waves[Index];
+            uint32 ImportedRate = 0;
+            uint16 NumChannels = 0;
+            if (!Wave->GetImportedSoundWaveData(Info.PCM, ImportedRate, NumChannels) || ImportedRate == 0 || NumChannels == 0)
+            {
+                Info.PCM.Empty();
+                Row.Error = EOptimizationError::SourceDecodeFailed;
+                continue;
+            }
+
+            Info.Wave = Wave;
+            Info.Duration = Wave->Duration;
+            Info.NumChannels = NumChannels;
+            Info.ImportedRate = (float)ImportedRate;
+            Info.NewSampleRate = Wave->SampleRateQuality;
+            Info.NewQuality = Wave->CompressionQuality;
+        }
+
+        ParallelFor(ChunkEnd - ChunkStart, [&Waves, &Settings, ChunkStart](int32 ChunkIndex)
+        {
+            FWaveInfo& Info = Waves[ChunkStart + ChunkIndex];
+            if (!Info.Wave)
+                return;
+
+            const int32 NumFrames = Info.PCM.Num() / (sizeof(int16) * Info.NumChannels);
+            Info.BandwidthHz = AnalyzeBandwidth((const int16*)Info.PCM.GetData(), NumFrames, Info.NumChannels, (int32)Info.ImportedRate, Settings.SpectralRolloff, Settings.MaxAnalysisSeconds);
+            Info.PCM.Empty();
+        });
+    }
+
+    // A cancelled batch leaves every wave as it was, analyzed or not
+    if (bCancelled)
+    {
+        for (int32 Index = 0; Index < Waves.Num(); Index++)
+        {
+            if (Waves[Index].Wave)
+                Rows[Index].Error = EOptimizationError::Cancelled;
+        }
+
+        UE_LOG(LogBatchTools, Log, TEXT("Audio batch cancelled; no sound waves were changed"));
+        Results.Reserve(Rows.Num());
+        for (const FTextureOptimizationResult& Row : Rows)
+            Results.Add(Row);
+        return Results;
+    }
+
+    // Lowest sample rate setting whose Nyquist frequency keeps the measured bandwidth; never raised
+    for (FWaveInfo& Info : Waves)
+    {
+        if (!bCanResample || !Info.Wave || Info.Duration < Settings.MinDurationSeconds)
+            continue;
+
+        const float CurrentRate = GetEffectiveRate(Info, Info.Wave->SampleRateQuality);
+        for (ESoundwaveSampleRateSettings Setting : SampleRateLadder)
+        {
+            const float Rate = GetEffectiveRate(Info, Setting);
+            if (Rate * 0.5f >= Info.BandwidthHz)
+            {
+                if (Rate < CurrentRate)
+                    Info.NewSampleRate = Setting;
+                break;
+            }
+        }
+    }
+
+    // Largest batch quality whose estimated total fits the budget; per-wave quality is never raised
+    auto GetWaveQuality = [&Settings](const FWaveInfo& Info, int32 BatchQuality)
+    {
+        const float Scale = Info.Wave->bLooping ? Settings.LoopQualityScale : 1.0f;
+        const int32 Quality = FMath::Max(Settings.MinQuality, FMath::RoundToInt(BatchQuality * Scale));
+        return FMath::Min(Info.Wave->CompressionQuality, Quality);
+    };
+    auto EstimateTotal = [&Waves, &GetWaveQuality, &GetEffectiveRate, &Settings](int32 BatchQuality)
+    {
+        int64 Total = 0;
+        for (const FWaveInfo& Info : Waves)
+        {
+            if (!Info.Wave)
+                continue;
+            const int32 Quality = Info.Duration < Settings.MinDurationSeconds ? Info.Wave->CompressionQuality : GetWaveQuality(Info, BatchQuality);
+            Total += EstimateCompressedBytes(Info.Duration, Info.NumChannels, GetEffectiveRate(Info, Info.NewSampleRate), Quality);
+        }
+        return Total;
+    };
+
+    int32 BatchQuality = 100;
+    const int64 BudgetBytes = (int64)((double)Settings.BudgetMB * 1024.0 * 1024.0);
+    if (BudgetBytes > 0 && EstimateTotal(BatchQuality) > BudgetBytes)
+    {
+        int32 Low = Settings.MinQuality;
+        int32 High = 100;
+        while (Low < High)
+        {
+            const int32 Mid = (Low + High + 1) / 2;
+            if (EstimateTotal(Mid) <= BudgetBytes)
+                Low = Mid;
+            else
+                High = Mid - 1;
+        }
+        BatchQuality = Low;
+
+        if (EstimateTotal(BatchQuality) > BudgetBytes)
+        {
+            UE_LOG(LogBatchTools, Warning, TEXT("Audio budget of %.0fMB cannot be met at MinQuality %d (%.1fMB estimated)"),
+                   Settings.BudgetMB, Settings.MinQuality, EstimateTotal(BatchQuality) / (1024.0 * 1024.0));
+        }
+    }
+
+    // Settings first, without PostEditChange, so nothing is recompressed per wave
+    TArray<USoundWave*> ChangedWaves;
+    for (int32 Index = 0; Index < Waves.Num(); Index++)
+    {
+        FWaveInfo& Info = Waves[Index];
+        if (!Info.Wave)
+            continue;
+
+        FTextureOptimizationResult& Row = Rows[Index];
+        USoundWave* Wave = Info.Wave;
+        if (Info.Duration >= Settings.MinDurationSeconds)
+            Info.NewQuality = GetWaveQuality(Info, BatchQuality);
+
+        const float OriginalRate = GetEffectiveRate(Info, Wave->SampleRateQuality);
+        const float FinalRate = GetEffectiveRate(Info, Info.NewSampleRate);
+        const int64 OriginalBytes = EstimateCompressedBytes(Info.Duration, Info.NumChannels, OriginalRate, Wave->CompressionQuality);
+        const int64 FinalBytes = EstimateCompressedBytes(Info.Duration, Info.NumChannels, FinalRate, Info.NewQuality);
+
+        Row.OriginalSampleRate = (uint32)OriginalRate;
+        Row.FinalSampleRate = (uint32)FinalRate;
+        Row.OriginalQuality = (uint8)FMath::Clamp(Wave->CompressionQuality, 0, 255);
+        Row.FinalQuality = (uint8)FMath::Clamp(Info.NewQuality, 0, 255);
+        // Modeled from duration, channels, rate and quality; the rebuild below is not measured
+        Row.OriginalBytes = OriginalBytes;
+        Row.FinalBytes = FinalBytes;
+        Row.bEstimated = true;
+
+        if (Info.NewQuality == Wave->CompressionQuality && FinalRate >= OriginalRate)
+        {
+            Row.FinalSampleRate = Row.OriginalSampleRate;
+            Row.FinalBytes = OriginalBytes;
+            Row.Error = EOptimizationError::AudioUnchanged;
+            continue;
+        }
+
+        Wave->Modify();
+        Wave->SampleRateQuality = Info.NewSampleRate;
+        Wave->CompressionQuality = Info.NewQuality;
+        ChangedWaves.Add(Wave);
+
+        // Streamed waves only keep their first chunk resident
+        const float SavedMB = (float)((double)(OriginalBytes - FinalBytes) / (1024.0 * 1024.0));
+        Row.FileSizeSavedMB = SavedMB;
+        Row.MemorySavedMB = Wave->IsStreaming(nullptr) ? 0.0f : SavedMB;
+        Row.bSuccess = true;
+    }
+
+    // One deferred rebuild pass for the whole batch
+    SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("InvalidatingSounds", "Invalidating {0} sound waves..."), FText::AsNumber(ChangedWaves.Num())));
+    for (USoundWave* Wave : ChangedWaves)
+    {
+        Wave->InvalidateCompressedData(true, false);
+        Wave->MarkPackageDirty();
+    }
+
+    SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("RebuildingSounds", "Rebuilding {0} sound waves..."), FText::AsNumber(ChangedWaves.Num())));
+    const ITargetPlatform* RunningPlatform = GetTargetPlatformManagerRef().GetRunningTargetPlatform();
+    if (Settings.bRebuildCompressedData && RunningPlatform && ChangedWaves.Num() > 0)
+    {
+        for (USoundWave* Wave : ChangedWaves)
+            Wave->BeginCacheForCookedPlatformData(RunningPlatform);
+
+        // Bounded wait; anything still building finishes on first use instead
+        TArray<USoundWave*> PendingWaves = ChangedWaves;
+        const double Deadline = FPlatformTime::Seconds() + Settings.RebuildTimeoutSeconds;
+        while (true)
+        {
+            PendingWaves.RemoveAllSwap([RunningPlatform](USoundWave* Wave) { return Wave->IsCachedCookedPlatformDataLoaded(RunningPlatform); });
+            if (PendingWaves.Num() == 0)
+                break;
+
+            if (SlowTask.ShouldCancel() || FPlatformTime::Seconds() >= Deadline)
+            {
+                UE_LOG(LogBatchTools, Warning, TEXT("Stopped waiting for %d sound waves to rebuild; their compressed data is built on first use"), PendingWaves.Num());
+                break;
+            }
+
+            // Builds finish on worker threads, but their results are only applied by the compiling manager
+            FAssetCompilingManager::Get().ProcessAsyncTasks();
+            SlowTask.TickProgress();
+            FPlatformProcess::Sleep(0.01f);
+        }
+    }
+
+    UE_LOG(LogBatchTools, Log, TEXT("Audio batch: %d/%d sound waves changed at batch quality %d"), ChangedWaves.Num(), SoundWaves.Num(), BatchQuality);
+
+    Results.Reserve(Rows.Num());
+    for (const FTextureOptimizationResult& Row : Rows)
+        Results.Add(Row);
+    return Results;
+}
+
+#undef LOCTEXT_NAMESPACE
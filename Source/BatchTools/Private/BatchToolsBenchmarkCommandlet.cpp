@@ -0,0 +1,365 @@
+#include "BatchToolsBenchmarkCommandlet.h"
+#include "BatchToolsModule.h"
+#include "BatchToolsPolicy.h"
+#include "BatchToolsStreamingSimulator.h"
+#include "Engine/Texture2D.h"
+#include "EditorFramework/AssetImportData.h"
+#include "TextureCompiler.h"
+#include "ImageUtils.h"
+#include "Interfaces/IPluginManager.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include <atomic>
+
+namespace BatchToolsBenchmark
+{
+    struct FSyntheticSize
+    {
+        int32 Width;
+        int32 Height;
+    };
+
+    // POT and NPOT sizes seen in production content
+    static const FSyntheticSize Sizes[] =
+    {
+        { 256, 256 }, { 512, 512 }, { 1024, 1024 }, { 2048, 2048 }, { 2048, 1024 },
+        { 3000, 2308 }, { 1920, 1080 }, { 1000, 750 }, { 600, 400 }, { 2500, 1250 }
+    };
+
+    static const TextureCompressionSettings CompressionSettings[] =
+    {
+        TC_Default, TC_Normalmap, TC_Grayscale, TC_Masks
+    };
+
+    struct FStageResult
+    {
+        FString Name;
+        int32 Items = 0;
+        double WallSeconds = 0.0;
+        double PeakGrowthMB = 0.0;
+
+        double GetThroughput() const { return WallSeconds > 0.0 ? (double)Items / WallSeconds : 0.0; }
+    };
+
+    // Absolute slack on the memory gate, small stages grow by a few MB of allocator noise
+    static constexpr double MemorySlackMB = 32.0;
+
+    // Times one stage and records how far used memory rose above its level at the stage start.
+    // PeakUsedPhysical is a process-wide high-water mark, so a sampler thread tracks the stage's own peak.
+    template <typename StageFunc>
+    static FStageResult RunStage(const TCHAR* Name, int32 Items, StageFunc&& Func)
+    {
+        FStageResult Stage;
+        Stage.Name = Name;
+        Stage.Items = Items;
+
+        const uint64 StartUsed = FPlatformMemory::GetStats().UsedPhysical;
+        std::atomic<bool> bStageDone = false;
+        std::atomic<uint64> PeakUsed = StartUsed;
+        TFuture<void> Sampler = Async(EAsyncExecution::Thread, [&bStageDone, &PeakUsed]()
+        {
+            while (!bStageDone)
+            {
+                const uint64 Used = FPlatformMemory::GetStats().UsedPhysical;
+                if (Used > PeakUsed)
+                    PeakUsed = Used;
+                FPlatformProcess::Sleep(0.005f);
+            }
+        });
+
+        const double StartTime = FPlatformTime::Seconds();
+        Func();
+        Stage.WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+        bStageDone = true;
+        Sampler.Wait();
+        const uint64 EndUsed = FPlatformMemory::GetStats().UsedPhysical;
+        const uint64 StagePeak = FMath::Max(PeakUsed.load(), EndUsed);
+        Stage.PeakGrowthMB = (double)(StagePeak - StartUsed) / (1024.0 * 1024.0);
+
+        UE_LOG(LogBatchTools, Display, TEXT("  %-20s %8.3fs %10.1f items/s %8.0fMB peak growth"), 
+               Name, Stage.WallSeconds, Stage.GetThroughput(), Stage.PeakGrowthMB);
+        return Stage;
+    }
+
+    static UTexture2D* CreateSyntheticTexture(int32 Index, const FString& SourceDir)
+    {
+        const FSyntheticSize& Size = Sizes[Index % UE_ARRAY_COUNT(Sizes)];
+        const TextureCompressionSettings Compression = CompressionSettings[(Index / UE_ARRAY_COUNT(Sizes)) % UE_ARRAY_COUNT(CompressionSettings)];
+        const bool bGrayscale = Compression == TC_Grayscale;
+        const bool bWithSource = (Index % 2) == 0;
+
+        const FName TextureName = MakeUniqueObjectName(GetTransientPackage(), UTexture2D::StaticClass(), *FString::Printf(TEXT("T_Benchmark_%d"), Index));
+        UTexture2D* Texture = NewObject<UTexture2D>(GetTransientPackage(), TextureName, RF_Transient);
+        Texture->Source.Init(Size.Width, Size.Height, 1, 1, bGrayscale ? TSF_G8 : TSF_BGRA8);
+        Texture->CompressionSettings = Compression;
+        Texture->SRGB = Compression == TC_Default;
+
+        // Cheap gradient so block compression has something to do
+        const int32 BytesPerPixel = bGrayscale ? 1 : 4;
+        uint8* Pixels = Texture->Source.LockMip(0);
+        for (int32 Y = 0; Y < Size.Height; Y++)
+        {
+            uint8* Row = Pixels + (int64)Y * Size.Width * BytesPerPixel;
+            for (int32 X = 0; X < Size.Width; X++)
+            {
+                for (int32 Channel = 0; Channel < BytesPerPixel; Channel++)
+                    Row[X * BytesPerPixel + Channel] = (uint8)((X * (Channel + 1) + Y * 3 + Index) & 0xFF);
+            }
+        }
+
+        if (bWithSource)
+        {
+            const FString SourcePath = SourceDir / TextureName.ToString() + TEXT(".png");
+            FImageView Image(Pixels, Size.Width, Size.Height, bGrayscale ? ERawImageFormat::G8 : ERawImageFormat::BGRA8);
+            if (FImageUtils::SaveImageByExtension(*SourcePath, Image))
+            {
+                Texture->AssetImportData = NewObject<UAssetImportData>(Texture, TEXT("AssetImportData"));
+                Texture->AssetImportData->Update(SourcePath);
+            }
+        }
+
+        Texture->Source.UnlockMip(0);
+        Texture->PostEditChange();
+        return Texture;
+    }
+
+    static TSharedRef<FJsonObject> ToJson(int32 Count, const TArray<FStageResult>& Stages)
+    {
+        TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+        Root->SetNumberField(TEXT("Count"), Count);
+
+        TArray<TSharedPtr<FJsonValue>> StageValues;
+        for (const FStageResult& Stage : Stages)
+        {
+            TSharedRef<FJsonObject> StageObject = MakeShared<FJsonObject>();
+            StageObject->SetStringField(TEXT("Name"), Stage.Name);
+            StageObject->SetNumberField(TEXT("WallSeconds"), Stage.WallSeconds);
+            StageObject->SetNumberField(TEXT("Throughput"), Stage.GetThroughput());
+            StageObject->SetNumberField(TEXT("PeakGrowthMB"), Stage.PeakGrowthMB);
+            StageValues.Add(MakeShared<FJsonValueObject>(StageObject));
+        }
+        Root->SetArrayField(TEXT("Stages"), StageValues);
+        return Root;
+    }
+
+    // Logs every metric outside the tolerance band and returns how many there were
+    static int32 CompareToBaseline(const FJsonObject& Baseline, int32 Count, const TArray<FStageResult>& Stages, double Tolerance)
+    {
+        if ((int32)Baseline.GetNumberField(TEXT("Count")) != Count)
+        {
+            UE_LOG(LogBatchTools, Warning, TEXT("Baseline was recorded with -Count=%d, skipping comparison"), (int32)Baseline.GetNumberField(TEXT("Count")));
+            return 0;
+        }
+
+        int32 NumRegressions = 0;
+        for (const TSharedPtr<FJsonValue>& StageValue : Baseline.GetArrayField(TEXT("Stages")))
+        {
+            const TSharedPtr<FJsonObject>& BaselineStage = StageValue->AsObject();
+            const FString Name = BaselineStage->GetStringField(TEXT("Name"));
+            const FStageResult* Stage = Stages.FindByPredicate([&Name](const FStageResult& Candidate) { return Candidate.Name == Name; });
+            if (!Stage)
+                continue;
+
+            const double BaselineSeconds = BaselineStage->GetNumberField(TEXT("WallSeconds"));
+            const double BaselineThroughput = BaselineStage->GetNumberField(TEXT("Throughput"));
+
+            if (Stage->WallSeconds > BaselineSeconds * (1.0 + Tolerance))
+            {
+                UE_LOG(LogBatchTools, Error, TEXT("%s: wall time %.3fs exceeds baseline %.3fs"), *Name, Stage->WallSeconds, BaselineSeconds);
+                NumRegressions++;
+            }
+            // Baselines recorded before the per-stage measurement carry the process peak, which is not comparable
+            double BaselineGrowthMB = 0.0;
+            if (BaselineStage->TryGetNumberField(TEXT("PeakGrowthMB"), BaselineGrowthMB) 
+                && Stage->PeakGrowthMB > BaselineGrowthMB * (1.0 + Tolerance) + MemorySlackMB)
+            {
+                UE_LOG(LogBatchTools, Error, TEXT("%s: peak memory growth %.0fMB exceeds baseline %.0fMB"), *Name, Stage->PeakGrowthMB, BaselineGrowthMB);
+                NumRegressions++;
+            }
+            if (Stage->GetThroughput() < BaselineThroughput * (1.0 - Tolerance))
+            {
+                UE_LOG(LogBatchTools, Error, TEXT("%s: throughput %.1f/s below baseline %.1f/s"), *Name, Stage->GetThroughput(), BaselineThroughput);
+                NumRegressions++;
+            }
+        }
+        return NumRegressions;
+    }
+}
+
+UBatchToolsBenchmarkCommandlet::UBatchToolsBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UBatchToolsBenchmarkCommandlet::Main(const FString& Params)
+{
+    using namespace BatchToolsBenchmark;
+
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamVals;
+    ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+    int32 Count = 2000;
+    if (const FString* CountParam = ParamVals.Find(TEXT("Count")))
+    {
+        Count = FMath::Max(1, FCString::Atoi(**CountParam));
+    }
+
+    double Tolerance = 0.25;
+    if (const FString* ToleranceParam = ParamVals.Find(TEXT("Tolerance")))
+    {
+        Tolerance = FMath::Max(0.0, FCString::Atod(**ToleranceParam));
+    }
+
+    FString BaselinePath;
+    if (const FString* BaselineParam = ParamVals.Find(TEXT("Baseline")))
+    {
+        BaselinePath = BaselineParam->TrimQuotes();
+    }
+    else if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("BatchTools")))
+    {
+        BaselinePath = Plugin->GetBaseDir() / TEXT("Config/BenchmarkBaseline.json");
+    }
+
+    FBatchToolsModule& BatchTools = FModuleManager::LoadModuleChecked<FBatchToolsModule>("BatchTools");
+    const FString SourceDir = FPaths::ProjectSavedDir() / TEXT("BatchTools/Benchmark");
+    IFileManager::Get().MakeDirectory(*SourceDir, true);
+
+    UE_LOG(LogBatchTools, Display, TEXT("BatchTools benchmark: %d synthetic textures"), Count);
+
+    TArray<FStageResult> Stages;
+    TArray<UTexture2D*> Textures;
+    TArray<FAssetData> Assets;
+    TArray<FTexturePolicyDecision> Decisions;
+    TArray<FTextureOptimizationResult> Plans;
+    TArray<FStreamingSimulationTexture> StreamingTextures;
+    FTextureOptimizationResultTable Results;
+
+    Stages.Add(RunStage(TEXT("Generate"), Count, [&]()
+    {
+        Textures.Reserve(Count);
+        for (int32 Index = 0; Index < Count; Index++)
+        {
+            UTexture2D* Texture = CreateSyntheticTexture(Index, SourceDir);
+            Texture->AddToRoot();
+            Textures.Add(Texture);
+        }
+        FTextureCompilingManager::Get().FinishAllCompilation();
+    }));
+
+    for (UTexture2D* Texture : Textures)
+    {
+        Assets.Emplace(Texture);
+    }
+
+    Stages.Add(RunStage(TEXT("Policy"), Count, [&]()
+    {
+        Decisions = FBatchToolsPolicy::Get().EvaluateBatch(Assets);
+    }));
+
+    Stages.Add(RunStage(TEXT("Plan"), Count, [&]()
+    {
+        Plans.Reserve(Count);
+        for (UTexture2D* Texture : Textures)
+        {
+            const bool bHasSource = Texture->AssetImportData && !Texture->AssetImportData->GetFirstFilename().IsEmpty();
+            Plans.Add(BatchTools.PlanTexture(Texture->GetFName(), Texture->GetSurfaceWidth(), Texture->GetSurfaceHeight(), 
+                                             bHasSource, EOptimizationMethod::SmartAuto, 512));
+        }
+    }));
+
+    Stages.Add(RunStage(TEXT("GatherMips"), Count, [&]()
+    {
+        StreamingTextures.Reserve(Count);
+        for (UTexture2D* Texture : Textures)
+        {
+            StreamingTextures.Add(FBatchToolsStreamingSimulator::GatherTexture(Texture));
+        }
+    }));
+
+    Stages.Add(RunStage(TEXT("Optimize"), Count, [&]()
+    {
+        Results = BatchTools.ProcessTextures(Assets, EOptimizationMethod::SmartAuto, 512);
+        FTextureCompilingManager::Get().FinishAllCompilation();
+    }));
+
+    Stages.Add(RunStage(TEXT("StreamingSimulation"), Count, [&]()
+    {
+        if (StreamingTextures.Num() == Results.Num())
+        {
+            FBatchToolsStreamingSimulator::Simulate(StreamingTextures, Results, FStreamingSimulationSettings::FromEngineDefaults());
+        }
+    }));
+
+    UE_LOG(LogBatchTools, Display, TEXT("Optimized %d/%d synthetic textures"), Results.ComputeTotals().NumSuccessful, Results.Num());
+
+    for (UTexture2D* Texture : Textures)
+    {
+        Texture->RemoveFromRoot();
+        Texture->MarkAsGarbage();
+    }
+    Textures.Reset();
+    Assets.Reset();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    IFileManager::Get().DeleteDirectory(*SourceDir, false, true);
+
+    const TSharedRef<FJsonObject> Report = ToJson(Count, Stages);
+    FString ReportText;
+    FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportText));
+    FFileHelper::SaveStringToFile(ReportText, *(FPaths::ProjectSavedDir() / TEXT("BatchTools/BenchmarkResults.json")));
+
+    if (BaselinePath.IsEmpty())
+    {
+        UE_LOG(LogBatchTools, Error, TEXT("No baseline path, pass -Baseline=<file>"));
+        return 1;
+    }
+
+    if (Switches.Contains(TEXT("WriteBaseline")))
+    {
+        if (!FFileHelper::SaveStringToFile(ReportText, *BaselinePath))
+        {
+            UE_LOG(LogBatchTools, Error, TEXT("Failed to write benchmark baseline %s"), *BaselinePath);
+            return 1;
+        }
+        UE_LOG(LogBatchTools, Display, TEXT("Wrote benchmark baseline %s"), *BaselinePath);
+        return 0;
+    }
+
+    // A missing baseline must not pass silently, CI would never compare against anything
+    FString BaselineText;
+    if (!FFileHelper::LoadFileToString(BaselineText, *BaselinePath))
+    {
+        UE_LOG(LogBatchTools, Error, TEXT("Benchmark baseline %s is missing or unreadable, run with -WriteBaseline to record one"), *BaselinePath);
+        return 1;
+    }
+
+    TSharedPtr<FJsonObject> Baseline;
+    if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineText), Baseline) || !Baseline.IsValid())
+    {
+        UE_LOG(LogBatchTools, Error, TEXT("Failed to parse benchmark baseline %s"), *BaselinePath);
+        return 1;
+    }
+
+    const int32 NumRegressions = CompareToBaseline(*Baseline, Count, Stages, Tolerance);
+    if (NumRegressions > 0)
+    {
+        UE_LOG(LogBatchTools, Error, TEXT("%d benchmark regressions beyond %.0f%% tolerance"), NumRegressions, Tolerance * 100.0);
+        return 1;
+    }
+
+    UE_LOG(LogBatchTools, Display, TEXT("Benchmark within %.0f%% of baseline"), Tolerance * 100.0);
+    return 0;
+}
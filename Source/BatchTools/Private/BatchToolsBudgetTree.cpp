@@ -0,0 +1,381 @@
+#include "BatchToolsBudgetTree.h"
+#include "BatchToolsModule.h"
+#include "BatchToolsPolicy.h"
+#include "BatchToolsTextureIndex.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Texture2D.h"
+#include "Misc/ConfigCacheIni.h"
+
+namespace BatchToolsBudgetTree
+{
+    static constexpr int64 Unlimited = MAX_int64;
+
+    static bool IsPathUnder(FStringView Path, FStringView Root)
+    {
+        return Path.StartsWith(Root) && (Path.Len() == Root.Len() || Path[Root.Len()] == TEXT('/'));
+    }
+}
+
+bool FFolderBudget::Parse(const FString& BudgetText, FFolderBudget& OutBudget)
+{
+    OutBudget = FFolderBudget();
+    const TCHAR* Stream = *BudgetText;
+
+    if (!FParse::Value(Stream, TEXT("Path="), OutBudget.Path) || OutBudget.Path.IsEmpty())
+        return false;
+    OutBudget.Path.RemoveFromEnd(TEXT("/"));
+
+    FParse::Value(Stream, TEXT("MaxMemoryMB="), OutBudget.MaxMemoryMB);
+    return OutBudget.MaxMemoryMB > 0.0f;
+}
+
+FBatchToolsBudgetSettings FBatchToolsBudgetSettings::Load()
+{
+    const TCHAR* Section = TEXT("BatchTools.Budgets");
+    const FString& ConfigFilename = FBatchToolsModule::GetConfigFilename();
+
+    FBatchToolsBudgetSettings Settings;
+    GConfig->GetString(Section, TEXT("RootPath"), Settings.RootPath, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MaxExtraLODBias"), Settings.MaxExtraLODBias, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MinSize"), Settings.MinSize, ConfigFilename);
+
+    TArray<FString> BudgetStrings;
+    GConfig->GetArray(Section, TEXT("Folders"), BudgetStrings, ConfigFilename);
+    for (const FString& BudgetString : BudgetStrings)
+    {
+        FFolderBudget Budget;
+        if (FFolderBudget::Parse(BudgetString, Budget))
+            Settings.Folders.Add(MoveTemp(Budget));
+        else
+            UE_LOG(LogBatchTools, Warning, TEXT("Ignoring folder budget without a path or MaxMemoryMB: %s"), *BudgetString);
+    }
+
+    Settings.RootPath.RemoveFromEnd(TEXT("/"));
+    Settings.MaxExtraLODBias = FMath::Clamp(Settings.MaxExtraLODBias, 1, 13);
+    Settings.MinSize = FMath::Max(1, Settings.MinSize);
+    return Settings;
+}
+
+bool FBatchToolsBudgetTree::ReadCost(const FAssetData& Asset, FAssetCost& OutCost)
+{
+    const FTextureIndexEntry Entry = FBatchToolsTextureIndex::ReadAssetTags(Asset);
+    if (Entry.Width <= 0 || Entry.Height <= 0)
+        return false;
+
+    const FTexturePolicyDecision Decision = FBatchToolsPolicy::Get().Evaluate(Asset);
+    OutCost.Width = Entry.Width;
+    OutCost.Height = Entry.Height;
+    OutCost.LODBias = Entry.LODBias;
+    OutCost.Format = Entry.Format;
+    OutCost.Bytes = Entry.ResidentBytes;
+    // Skipped textures still count toward their folders but are never reduced
+    OutCost.Weight = Decision.bSkip ? 0.0f : Decision.BudgetWeight;
+    return true;
+}
+
+int32 FBatchToolsBudgetTree::FindFolder(FName Path) const
+{
+    const int32* Folder = NodeByPath.Find(Path);
+    return Folder ? *Folder : INDEX_NONE;
+}
+
+int32 FBatchToolsBudgetTree::FindOrAddFolder(FName Path)
+{
+    if (const int32* Existing = NodeByPath.Find(Path))
+        return *Existing;
+
+    const FString PathString = Path.ToString();
+    if (!BatchToolsBudgetTree::IsPathUnder(PathString, Settings.RootPath))
+        return INDEX_NONE;
+
+    int32 Parent = INDEX_NONE;
+    if (PathString.Len() > Settings.RootPath.Len())
+    {
+        int32 Slash = INDEX_NONE;
+        PathString.FindLastChar(TEXT('/'), Slash);
+        Parent = FindOrAddFolder(FName(PathString.Left(Slash)));
+    }
+
+    const int32 Folder = Nodes.AddDefaulted();
+    Nodes[Folder].Path = Path;
+    Nodes[Folder].Parent = Parent;
+    if (Parent != INDEX_NONE)
+    {
+        Nodes[Folder].Depth = Nodes[Parent].Depth + 1;
+        Nodes[Parent].Children.Add(Folder);
+    }
+    NodeByPath.Add(Path, Folder);
+    return Folder;
+}
+
+void FBatchToolsBudgetTree::Build(const FBatchToolsBudgetSettings& InSettings)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    Settings = InSettings;
+    Nodes.Reset();
+    NodeByPath.Reset();
+    AssetCosts.Reset();
+    Version++;
+
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+    Filter.PackagePaths.Add(FName(*Settings.RootPath));
+    Filter.bRecursivePaths = true;
+
+    TArray<FAssetData> Assets;
+    FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().GetAssets(Filter, Assets);
+
+    TArray<FAssetCost> Costs;
+    TArray<bool> bValid;
+    Costs.SetNum(Assets.Num());
+    bValid.SetNumZeroed(Assets.Num());
+    ParallelFor(Assets.Num(), [&Assets, &Costs, &bValid](int32 Index)
+    {
+        bValid[Index] = ReadCost(Assets[Index], Costs[Index]);
+    });
+
+    RootFolder = FindOrAddFolder(FName(*Settings.RootPath));
+    AssetCosts.Reserve(Assets.Num());
+    for (int32 Index = 0; Index < Assets.Num(); Index++)
+    {
+        const int32 Folder = bValid[Index] ? FindOrAddFolder(Assets[Index].PackagePath) : INDEX_NONE;
+        if (Folder == INDEX_NONE)
+            continue;
+
+        Costs[Index].Folder = Folder;
+        Nodes[Folder].OwnBytes += Costs[Index].Bytes;
+        Nodes[Folder].Assets.Add(Assets[Index].PackageName);
+        AssetCosts.Add(Assets[Index].PackageName, Costs[Index]);
+    }
+
+    // Bottom-up rollup, deepest level first; nodes of one level only read their children
+    TArray<TArray<int32>> Levels;
+    for (int32 Folder = 0; Folder < Nodes.Num(); Folder++)
+    {
+        if (Levels.Num() <= Nodes[Folder].Depth)
+            Levels.SetNum(Nodes[Folder].Depth + 1);
+        Levels[Nodes[Folder].Depth].Add(Folder);
+    }
+
+    for (int32 Depth = Levels.Num() - 1; Depth >= 0; Depth--)
+    {
+        const TArray<int32>& Level = Levels[Depth];
+        ParallelFor(Level.Num(), [this, &Level](int32 Index)
+        {
+            FFolderNode& Node = Nodes[Level[Index]];
+            Node.RollupBytes = Node.OwnBytes;
+            for (int32 Child : Node.Children)
+                Node.RollupBytes += Nodes[Child].RollupBytes;
+        });
+    }
+
+    ApplySettings(Settings);
+
+    UE_LOG(LogBatchTools, Log, TEXT("Budget tree built: %d textures in %d folders under %s (%.1fMB) in %.2fs"), AssetCosts.Num(), Nodes.Num(),
+           *Settings.RootPath, RootFolder != INDEX_NONE ? Nodes[RootFolder].RollupBytes / (1024.0 * 1024.0) : 0.0, FPlatformTime::Seconds() - StartTime);
+}
+
+void FBatchToolsBudgetTree::ApplySettings(const FBatchToolsBudgetSettings& InSettings)
+{
+    check(InSettings.RootPath == Settings.RootPath || !IsBuilt());
+    Settings = InSettings;
+
+    for (FFolderNode& Node : Nodes)
+        Node.BudgetBytes = 0;
+
+    // Budgets on folders without textures still constrain their subtree
+    for (const FFolderBudget& Budget : Settings.Folders)
+    {
+        const int32 Folder = FindOrAddFolder(FName(*Budget.Path));
+        if (Folder != INDEX_NONE)
+            Nodes[Folder].BudgetBytes = (int64)((double)Budget.MaxMemoryMB * 1024.0 * 1024.0);
+        else
+            UE_LOG(LogBatchTools, Warning, TEXT("Folder budget %s is outside %s and was ignored"), *Budget.Path, *Settings.RootPath);
+    }
+    Version++;
+}
+
+void FBatchToolsBudgetTree::AddToPath(int32 Folder, int64 DeltaBytes)
+{
+    Nodes[Folder].OwnBytes += DeltaBytes;
+    for (int32 Node = Folder; Node != INDEX_NONE; Node = Nodes[Node].Parent)
+        Nodes[Node].RollupBytes += DeltaBytes;
+    Version++;
+}
+
+void FBatchToolsBudgetTree::RemoveAsset(FName PackageName)
+{
+    FAssetCost Cost;
+    if (!AssetCosts.RemoveAndCopyValue(PackageName, Cost))
+        return;
+
+    Nodes[Cost.Folder].Assets.RemoveSingleSwap(PackageName);
+    AddToPath(Cost.Folder, -Cost.Bytes);
+}
+
+void FBatchToolsBudgetTree::UpdateAsset(const FAssetData& Asset)
+{
+    if (!IsBuilt())
+        return;
+
+    // A moved texture leaves its old path and joins the new one
+    RemoveAsset(Asset.PackageName);
+
+    FAssetCost Cost;
+    if (!ReadCost(Asset, Cost))
+        return;
+
+    Cost.Folder = FindOrAddFolder(Asset.PackagePath);
+    if (Cost.Folder == INDEX_NONE)
+        return;
+
+    Nodes[Cost.Folder].Assets.Add(Asset.PackageName);
+    AssetCosts.Add(Asset.PackageName, Cost);
+    AddToPath(Cost.Folder, Cost.Bytes);
+}
+
+int64 FBatchToolsBudgetTree::GetTargetBytes(int32 Folder) const
+{
+    using namespace BatchToolsBudgetTree;
+
+    const FFolderNode& Node = Nodes[Folder];
+    if (Node.TargetVersion == Version)
+        return Node.TargetBytes;
+
+    int64 Allotment = Unlimited;
+    int64 Headroom = 0;
+    if (Node.Parent != INDEX_NONE)
+    {
+        const FFolderNode& Parent = Nodes[Node.Parent];
+        const int64 ParentTarget = GetTargetBytes(Node.Parent);
+        if (ParentTarget != Unlimited)
+        {
+            if (Parent.RollupBytes > ParentTarget)
+            {
+                // Over-budget parents shrink every child by the same ratio
+                Allotment = (int64)((double)Node.RollupBytes * (double)ParentTarget / (double)Parent.RollupBytes);
+            }
+            else
+            {
+                Headroom = ParentTarget - Parent.RollupBytes;
+                Allotment = Node.RollupBytes + Headroom;
+            }
+        }
+    }
+
+    Node.TargetBytes = Node.BudgetBytes > 0 ? FMath::Min(Allotment, Node.BudgetBytes + Headroom) : Allotment;
+    Node.TargetVersion = Version;
+    return Node.TargetBytes;
+}
+
+bool FBatchToolsBudgetTree::IsUnderPaths(int32 Folder, const TArray<FString>& Paths) const
+{
+    TStringBuilder<256> FolderPath;
+    Nodes[Folder].Path.ToString(FolderPath);
+    for (const FString& Path : Paths)
+    {
+        FStringView Root = Path;
+        if (Root.EndsWith(TEXT('/')))
+            Root.LeftChopInline(1);
+        if (BatchToolsBudgetTree::IsPathUnder(FolderPath.ToView(), Root))
+            return true;
+    }
+    return false;
+}
+
+TArray<int32> FBatchToolsBudgetTree::GetReportedFolders(const TArray<FString>& Paths) const
+{
+    TArray<int32> Folders;
+    for (int32 Folder = 0; Folder < Nodes.Num(); Folder++)
+    {
+        if ((Nodes[Folder].BudgetBytes > 0 || IsOverBudget(Folder)) && IsUnderPaths(Folder, Paths))
+            Folders.Add(Folder);
+    }
+
+    Folders.Sort([this](int32 A, int32 B) { return Nodes[A].Path.LexicalLess(Nodes[B].Path); });
+    return Folders;
+}
+
+TArray<FBudgetReduction> FBatchToolsBudgetTree::PlanReductions(const TArray<FString>& Paths) const
+{
+    // Every target is cached before the parallel pass, which only reads them
+    TArray<int32> OverBudgetFolders;
+    for (int32 Folder = 0; Folder < Nodes.Num(); Folder++)
+    {
+        if (IsOverBudget(Folder) && Nodes[Folder].OwnBytes > 0 && IsUnderPaths(Folder, Paths))
+            OverBudgetFolders.Add(Folder);
+    }
+
+    TArray<TArray<FBudgetReduction>> FolderReductions;
+    FolderReductions.SetNum(OverBudgetFolders.Num());
+
+    ParallelFor(OverBudgetFolders.Num(), [this, &OverBudgetFolders, &FolderReductions](int32 Index)
+    {
+        const FFolderNode& Node = Nodes[OverBudgetFolders[Index]];
+
+        // The folder's own textures take the same share of the cut as each child subtree
+        const double Scale = (double)Node.TargetBytes / (double)FMath::Max<int64>(1, Node.RollupBytes);
+        const int64 BytesToRemove = Node.OwnBytes - (int64)((double)Node.OwnBytes * Scale);
+
+        struct FCandidate
+        {
+            const FAssetCost* Cost = nullptr;
+            FName PackageName;
+            int32 Steps = 0;
+            int64 Bytes = 0;
+            double Priority = 0.0;
+        };
+
+        // Largest cost per unit of BudgetWeight first; weight 0 is never reduced
+        auto HigherPriority = [](const FCandidate& A, const FCandidate& B) { return A.Priority > B.Priority; };
+        TArray<FCandidate> Heap;
+        TArray<FCandidate> Reduced;
+        for (FName PackageName : Node.Assets)
+        {
+            const FAssetCost& Cost = AssetCosts.FindChecked(PackageName);
+            if (Cost.Weight > 0.0f && Cost.Bytes > 0)
+                Heap.HeapPush({ &Cost, PackageName, 0, Cost.Bytes, (double)Cost.Bytes / Cost.Weight }, HigherPriority);
+        }
+
+        int64 Removed = 0;
+        while (Removed < BytesToRemove && Heap.Num() > 0)
+        {
+            FCandidate Candidate;
+            Heap.HeapPop(Candidate, HigherPriority, EAllowShrinking::No);
+
+            const FAssetCost& Cost = *Candidate.Cost;
+            const int32 NextBias = Cost.LODBias + Candidate.Steps + 1;
+            if (Candidate.Steps >= Settings.MaxExtraLODBias || (FMath::Max(Cost.Width, Cost.Height) >> NextBias) < Settings.MinSize)
+            {
+                if (Candidate.Steps > 0)
+                    Reduced.Add(Candidate);
+                continue;
+            }
+
+            const int64 NextBytes = FBatchToolsTextureIndex::EstimateResidentBytes(Cost.Width, Cost.Height, Cost.Format, NextBias);
+            Removed += Candidate.Bytes - NextBytes;
+            Candidate.Steps++;
+            Candidate.Bytes = NextBytes;
+            Candidate.Priority = (double)NextBytes / Cost.Weight;
+            Heap.HeapPush(Candidate, HigherPriority);
+        }
+
+        for (const FCandidate& Candidate : Heap)
+        {
+            if (Candidate.Steps > 0)
+                Reduced.Add(Candidate);
+        }
+
+        for (const FCandidate& Candidate : Reduced)
+            FolderReductions[Index].Add({ Candidate.PackageName, Candidate.Cost->LODBias + Candidate.Steps });
+    });
+
+    TArray<FBudgetReduction> Reductions;
+    for (TArray<FBudgetReduction>& Folder : FolderReductions)
+        Reductions.Append(MoveTemp(Folder));
+    return Reductions;
+}
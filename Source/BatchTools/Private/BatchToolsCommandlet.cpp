@@ -0,0 +1,184 @@
+#include "BatchToolsCommandlet.h"
+#include "BatchToolsModule.h"
+#include "BatchToolsShardCoordinator.h"
+#include "BatchToolsDDCPrewarmer.h"
+#include "BatchToolsStreamingTelemetry.h"
+#include "Engine/Texture.h"
+#include "Engine/StaticMesh.h"
+#include "Sound/SoundWave.h"
+#include "FileHelpers.h"
+#include "UObject/Package.h"
+
+UBatchToolsCommandlet::UBatchToolsCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UBatchToolsCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamVals;
+    ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+    EOptimizationMethod Method = EOptimizationMethod::SmartAuto;
+    if (const FString* MethodParam = ParamVals.Find(TEXT("Method")))
+    {
+        if (!LexTryParseString(Method, **MethodParam))
+        {
+            UE_LOG(LogBatchTools, Error, TEXT("Unknown optimization method '%s'"), **MethodParam);
+            return 1;
+        }
+    }
+
+    int32 TargetResolution = 512;
+    if (const FString* TargetParam = ParamVals.Find(TEXT("Target")))
+    {
+        TargetResolution = FMath::Max(1, FCString::Atoi(**TargetParam));
+    }
+
+    FBatchToolsModule& BatchTools = FModuleManager::LoadModuleChecked<FBatchToolsModule>("BatchTools");
+
+    // Worker launched by a sharded run
+    if (const FString* QueueParam = ParamVals.Find(TEXT("ShardQueue")))
+    {
+        const int32 NumShards = FBatchToolsShardCoordinator::RunWorker(BatchTools, QueueParam->TrimQuotes(), Method, TargetResolution);
+        UE_LOG(LogBatchTools, Display, TEXT("Shard worker finished after %d shards"), NumShards);
+        BatchTools.WaitForDerivedData();
+        return 0;
+    }
+
+    const FString* PathsParam = ParamVals.Find(TEXT("Paths"));
+    if (!PathsParam || PathsParam->IsEmpty())
+    {
+        UE_LOG(LogBatchTools, Error, TEXT("Usage: -run=BatchTools -Paths=/Game/A,/Game/B [-Method=LODBias|Reimport|Smart|MaxSize] [-Target=512] [-Workers=N] [-Telemetry=Dir,File.csv] [-Budgets] [-Meshes] [-Sounds] [-Save] [-PrewarmDDC]"));
+        return 1;
+    }
+
+    TArray<FString> Paths;
+    PathsParam->ParseIntoArray(Paths, TEXT(","), true);
+
+    TArray<FAssetData> TextureAssets = BatchTools.GetTexturesFromPaths(Paths);
+
+    int32 NumWorkers = 0;
+    if (const FString* WorkersParam = ParamVals.Find(TEXT("Workers")))
+    {
+        NumWorkers = FMath::Max(0, FCString::Atoi(**WorkersParam));
+    }
+
+    FTextureOptimizationResultTable Results;
+    if (const FString* TelemetryParam = ParamVals.Find(TEXT("Telemetry")))
+    {
+        TArray<FString> CaptureInputs;
+        TelemetryParam->TrimQuotes().ParseIntoArray(CaptureInputs, TEXT(","), true);
+
+        FBatchToolsStreamingTelemetry Telemetry;
+        Telemetry.IngestFiles(FBatchToolsStreamingTelemetry::FindCaptureFiles(CaptureInputs));
+        if (Telemetry.NumRuns() == 0)
+        {
+            UE_LOG(LogBatchTools, Error, TEXT("No usable streaming captures in '%s'"), **TelemetryParam);
+            return 1;
+        }
+
+        UE_LOG(LogBatchTools, Display, TEXT("Applying streaming telemetry from %d runs to %d textures"), Telemetry.NumRuns(), TextureAssets.Num());
+        Results = BatchTools.ApplyStreamingTelemetry(TextureAssets, Telemetry);
+    }
+    else if (Switches.Contains(TEXT("Budgets")))
+    {
+        UE_LOG(LogBatchTools, Display, TEXT("Enforcing [BatchTools.Budgets] folder budgets under %d paths"), Paths.Num());
+        Results = BatchTools.EnforceFolderBudgets(Paths);
+
+        const FTextureOptimizationTotals BudgetTotals = Results.ComputeTotals();
+        if (BudgetTotals.GetErrorCount(EOptimizationError::StillOverBudget) > 0)
+        {
+            UE_LOG(LogBatchTools, Warning, TEXT("%d folders are still over budget"), BudgetTotals.GetErrorCount(EOptimizationError::StillOverBudget));
+        }
+    }
+    else
+    {
+        UE_LOG(LogBatchTools, Display, TEXT("Optimizing %d textures (%s, target %dpx, %d workers)"), TextureAssets.Num(), LexToString(Method), TargetResolution, FMath::Max(1, NumWorkers));
+
+        // Workers save their own packages, so -Save only matters for the in-process path
+        Results = NumWorkers > 1
+            ? FBatchToolsShardCoordinator::Run(TextureAssets, Method, TargetResolution, NumWorkers, FBatchToolsShardSettings::Load().ShardsPerWorker)
+            : BatchTools.ProcessTextures(TextureAssets, Method, TargetResolution);
+    }
+
+    const FTextureOptimizationTotals Totals = Results.ComputeTotals();
+
+    UE_LOG(LogBatchTools, Display, TEXT("Optimized %d/%d textures, %dMB VRAM saved"), Totals.NumSuccessful, Results.Num(), FMath::RoundToInt(Totals.VRAMSavedMB));
+
+    TArray<FAssetData> MeshAssets;
+    if (Switches.Contains(TEXT("Meshes")))
+    {
+        MeshAssets = BatchTools.GetAssetsFromPaths(Paths, { UStaticMesh::StaticClass()->GetClassPathName() });
+        const FTextureOptimizationResultTable MeshResults = BatchTools.ProcessStaticMeshes(MeshAssets);
+        const FTextureOptimizationTotals MeshTotals = MeshResults.ComputeTotals();
+
+        UE_LOG(LogBatchTools, Display, TEXT("Reduced %d/%d static meshes, %dMB saved"), MeshTotals.NumSuccessful, MeshResults.Num(), FMath::RoundToInt(MeshTotals.VRAMSavedMB));
+        if (MeshTotals.NumOverBudget > 0)
+        {
+            UE_LOG(LogBatchTools, Warning, TEXT("%d static meshes are in folders still over their budget"), MeshTotals.NumOverBudget);
+        }
+    }
+
+    TArray<FAssetData> SoundAssets;
+    if (Switches.Contains(TEXT("Sounds")))
+    {
+        SoundAssets = BatchTools.GetAssetsFromPaths(Paths, { USoundWave::StaticClass()->GetClassPathName() });
+        const FTextureOptimizationResultTable SoundResults = BatchTools.ProcessSoundWaves(SoundAssets);
+        const FTextureOptimizationTotals SoundTotals = SoundResults.ComputeTotals();
+
+        UE_LOG(LogBatchTools, Display, TEXT("Changed %d/%d sound waves, %dMB memory and %dMB disk saved (estimated)"), SoundTotals.NumSuccessful, SoundResults.Num(), FMath::RoundToInt(SoundTotals.AudioMemorySavedMB), FMath::RoundToInt(SoundTotals.FileSizeSavedMB));
+    }
+
+    // ProcessTextures already queued the prewarm when it is enabled in the ini
+    if (Switches.Contains(TEXT("PrewarmDDC")) && (NumWorkers > 1 || !FBatchToolsDDCPrewarmSettings::Load().bEnabled))
+    {
+        // Keyed by object path, textures in different folders can share an asset name
+        TSet<FSoftObjectPath> OptimizedPaths;
+        for (int32 Row = 0; Row < Results.Num(); Row++)
+        {
+            if (Results.IsSuccess(Row))
+                OptimizedPaths.Add(FSoftObjectPath(FTopLevelAssetPath(Results.GetPackageName(Row), Results.GetTextureName(Row))));
+        }
+
+        TArray<UTexture*> OptimizedTextures;
+        for (const FAssetData& AssetData : TextureAssets)
+        {
+            if (!OptimizedPaths.Contains(AssetData.GetSoftObjectPath()))
+                continue;
+            if (UTexture* Texture = Cast<UTexture>(AssetData.GetAsset()))
+                OptimizedTextures.Add(Texture);
+        }
+        BatchTools.PrewarmDerivedData(OptimizedTextures);
+    }
+    BatchTools.WaitForDerivedData();
+
+    if (Switches.Contains(TEXT("Save")))
+    {
+        TArray<FAssetData> ModifiedAssets = TextureAssets;
+        ModifiedAssets.Append(MeshAssets);
+        ModifiedAssets.Append(SoundAssets);
+
+        TArray<UPackage*> DirtyPackages;
+        for (const FAssetData& AssetData : ModifiedAssets)
+        {
+            UPackage* Package = FindPackage(nullptr, *AssetData.PackageName.ToString());
+            if (Package && Package->IsDirty())
+                DirtyPackages.Add(Package);
+        }
+
+        if (DirtyPackages.Num() > 0 && !UEditorLoadingAndSavingUtils::SavePackages(DirtyPackages, false))
+        {
+            UE_LOG(LogBatchTools, Error, TEXT("Failed to save %d modified packages"), DirtyPackages.Num());
+            return 1;
+        }
+        UE_LOG(LogBatchTools, Display, TEXT("Saved %d modified packages"), DirtyPackages.Num());
+    }
+
+    return 0;
+}
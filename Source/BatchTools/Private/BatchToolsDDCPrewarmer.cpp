@@ -0,0 +1,209 @@
+#include "BatchToolsDDCPrewarmer.h"
+#include "BatchToolsModule.h"
+#include "Engine/Texture.h"
+#include "AssetCompilingManager.h"
+#include "Interfaces/ITargetPlatform.h"
+#include "Interfaces/ITargetPlatformManagerModule.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "FBatchToolsModule"
+
+FBatchToolsDDCPrewarmSettings FBatchToolsDDCPrewarmSettings::Load()
+{
+    const TCHAR* Section = TEXT("BatchTools.DDCPrewarm");
+    const FString& ConfigFilename = FBatchToolsModule::GetConfigFilename();
+
+    FBatchToolsDDCPrewarmSettings Settings;
+    GConfig->GetBool(Section, TEXT("bEnabled"), Settings.bEnabled, ConfigFilename);
+    GConfig->GetArray(Section, TEXT("TargetPlatforms"), Settings.TargetPlatforms, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MaxInFlight"), Settings.MaxInFlight, ConfigFilename);
+    GConfig->GetFloat(Section, TEXT("HitThresholdMs"), Settings.HitThresholdMs, ConfigFilename);
+
+    Settings.MaxInFlight = FMath::Max(1, Settings.MaxInFlight);
+    return Settings;
+}
+
+FBatchToolsDDCPrewarmer::FBatchToolsDDCPrewarmer(const FBatchToolsDDCPrewarmSettings& InSettings)
+    : Settings(InSettings)
+{
+    ITargetPlatformManagerModule& TargetPlatformManager = GetTargetPlatformManagerRef();
+
+    if (Settings.TargetPlatforms.Num() > 0)
+    {
+        for (const FString& PlatformName : Settings.TargetPlatforms)
+        {
+            if (ITargetPlatform* Platform = TargetPlatformManager.FindTargetPlatform(PlatformName))
+                Platforms.Add(Platform);
+            else
+                UE_LOG(LogBatchTools, Warning, TEXT("DDC prewarm: unknown target platform '%s'"), *PlatformName);
+        }
+    }
+    else
+    {
+        for (ITargetPlatform* Platform : TargetPlatformManager.GetActiveTargetPlatforms())
+            Platforms.Add(Platform);
+    }
+}
+
+FBatchToolsDDCPrewarmer::~FBatchToolsDDCPrewarmer()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+}
+
+void FBatchToolsDDCPrewarmer::Prewarm(const TArray<UTexture*>& Textures)
+{
+    if (Platforms.Num() == 0 || Textures.Num() == 0)
+        return;
+
+    if (IsIdle())
+    {
+        PrewarmStartTime = FPlatformTime::Seconds();
+        LastPollTime = PrewarmStartTime;
+    }
+
+    for (UTexture* Texture : Textures)
+    {
+        if (!Texture)
+            continue;
+
+        int32* ExistingStats = StatsByTexture.Find(FObjectKey(Texture));
+        int32 StatsIndex = ExistingStats ? *ExistingStats : INDEX_NONE;
+        if (StatsIndex == INDEX_NONE)
+        {
+            StatsIndex = Stats.AddDefaulted();
+            Stats[StatsIndex].TextureName = Texture->GetName();
+            StatsByTexture.Add(FObjectKey(Texture), StatsIndex);
+        }
+
+        for (const ITargetPlatform* Platform : Platforms)
+        {
+            FPrewarmJob& Job = PendingJobs.AddDefaulted_GetRef();
+            Job.Texture = Texture;
+            Job.Platform = Platform;
+            Job.StatsIndex = StatsIndex;
+        }
+    }
+
+    if (!TickerHandle.IsValid())
+    {
+        // Polled every frame, a coarser interval would push every cache hit above HitThresholdMs
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBatchToolsDDCPrewarmer::Tick), 0.0f);
+    }
+
+    UE_LOG(LogBatchTools, Log, TEXT("DDC prewarm queued %d textures for %d platforms"), Textures.Num(), Platforms.Num());
+}
+
+bool FBatchToolsDDCPrewarmer::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    // Retire finished builds; the data is in the DDC now, so drop the in-memory copy
+    for (int32 JobIndex = ActiveJobs.Num() - 1; JobIndex >= 0; JobIndex--)
+    {
+        FPrewarmJob& Job = ActiveJobs[JobIndex];
+        UTexture* Texture = Job.Texture.Get();
+        if (Texture && !Texture->IsCachedCookedPlatformDataLoaded(Job.Platform))
+            continue;
+
+        if (Texture)
+        {
+            // The build finished between the previous poll and this one; only classify it when
+            // that whole window falls on one side of the threshold
+            const double LatestMs = (Now - Job.StartTime) * 1000.0;
+            const double EarliestMs = FMath::Max(0.0, LastPollTime - Job.StartTime) * 1000.0;
+            FDDCPrewarmTextureStats& TextureStats = Stats[Job.StatsIndex];
+            TextureStats.BuildSeconds += Now - Job.StartTime;
+            if (LatestMs <= Settings.HitThresholdMs)
+                TextureStats.Hits++;
+            else if (EarliestMs > Settings.HitThresholdMs)
+                TextureStats.Misses++;
+            else
+                TextureStats.Unclassified++;
+
+            Texture->ClearCachedCookedPlatformData(Job.Platform);
+        }
+
+        ActiveJobs.RemoveAtSwap(JobIndex);
+    }
+    LastPollTime = Now;
+
+    // Keep the build pipeline full
+    while (ActiveJobs.Num() < Settings.MaxInFlight && NextPendingJob < PendingJobs.Num())
+    {
+        FPrewarmJob Job = PendingJobs[NextPendingJob++];
+        if (UTexture* Texture = Job.Texture.Get())
+        {
+            Job.StartTime = FPlatformTime::Seconds();
+            Texture->BeginCacheForCookedPlatformData(Job.Platform);
+            ActiveJobs.Add(Job);
+        }
+    }
+
+    if (ActiveJobs.Num() == 0 && NextPendingJob >= PendingJobs.Num())
+    {
+        PendingJobs.Reset();
+        NextPendingJob = 0;
+        ReportAndReset();
+        TickerHandle.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+void FBatchToolsDDCPrewarmer::WaitForCompletion()
+{
+    if (!TickerHandle.IsValid())
+        return;
+
+    // Drive the queue here instead of from the core ticker
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+
+    while (Tick(0.0f))
+    {
+        FAssetCompilingManager::Get().ProcessAsyncTasks();
+        FPlatformProcess::Sleep(0.01f);
+    }
+}
+
+void FBatchToolsDDCPrewarmer::ReportAndReset()
+{
+    int32 TotalHits = 0;
+    int32 TotalMisses = 0;
+    int32 TotalUnclassified = 0;
+
+    Stats.Sort([](const FDDCPrewarmTextureStats& A, const FDDCPrewarmTextureStats& B) { return A.BuildSeconds > B.BuildSeconds; });
+    for (const FDDCPrewarmTextureStats& TextureStats : Stats)
+    {
+        TotalHits += TextureStats.Hits;
+        TotalMisses += TextureStats.Misses;
+        TotalUnclassified += TextureStats.Unclassified;
+        UE_LOG(LogBatchTools, Log, TEXT("DDC prewarm %s: %.2fs (%d hit, %d miss, %d unclassified)"), 
+               *TextureStats.TextureName, TextureStats.BuildSeconds, TextureStats.Hits, TextureStats.Misses, TextureStats.Unclassified);
+    }
+
+    const double TotalSeconds = FPlatformTime::Seconds() - PrewarmStartTime;
+    UE_LOG(LogBatchTools, Log, TEXT("DDC prewarm complete: %d textures, %d cache hits, %d misses, %d unclassified in %.1fs"), 
+           Stats.Num(), TotalHits, TotalMisses, TotalUnclassified, TotalSeconds);
+
+    if (!IsRunningCommandlet())
+    {
+        FNotificationInfo Info(FText::Format(
+            LOCTEXT("DDCPrewarmNotification", "DDC prewarm complete: {0} textures, {1} cache hits, {2} built in {3}s"),
+            FText::AsNumber(Stats.Num()),
+            FText::AsNumber(TotalHits),
+            FText::AsNumber(TotalMisses),
+            FText::AsNumber(FMath::RoundToInt(TotalSeconds))
+        ));
+        Info.ExpireDuration = 5.0f;
+        FSlateNotificationManager::Get().AddNotification(Info);
+    }
+
+    Stats.Reset();
+    StatsByTexture.Reset();
+}
+
+#undef LOCTEXT_NAMESPACE
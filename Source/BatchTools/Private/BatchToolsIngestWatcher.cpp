@@ -0,0 +1,157 @@
+#include "BatchToolsIngestWatcher.h"
+#include "BatchToolsPolicy.h"
+#include "Editor.h"
+#include "Subsystems/ImportSubsystem.h"
+#include "Engine/Texture.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "FBatchToolsModule"
+
+FBatchToolsIngestSettings FBatchToolsIngestSettings::Load()
+{
+    const TCHAR* Section = TEXT("BatchTools.Ingest");
+    const FString& ConfigFilename = FBatchToolsModule::GetConfigFilename();
+
+    FBatchToolsIngestSettings Settings;
+    GConfig->GetBool(Section, TEXT("bEnabled"), Settings.bEnabled, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("TargetResolution"), Settings.TargetResolution, ConfigFilename);
+    GConfig->GetFloat(Section, TEXT("CoalesceSeconds"), Settings.CoalesceSeconds, ConfigFilename);
+    GConfig->GetFloat(Section, TEXT("TimeBudgetMs"), Settings.TimeBudgetMs, ConfigFilename);
+
+    FString MethodName;
+    if (GConfig->GetString(Section, TEXT("Method"), MethodName, ConfigFilename) && !LexTryParseString(Settings.Method, *MethodName))
+    {
+        UE_LOG(LogBatchTools, Warning, TEXT("Unknown ingest optimization method '%s'"), *MethodName);
+    }
+
+    Settings.TargetResolution = FMath::Max(1, Settings.TargetResolution);
+    Settings.TimeBudgetMs = FMath::Max(0.1f, Settings.TimeBudgetMs);
+    return Settings;
+}
+
+FBatchToolsIngestWatcher::FBatchToolsIngestWatcher(FBatchToolsModule& InModule, const FBatchToolsIngestSettings& InSettings)
+    : Module(InModule)
+    , Settings(InSettings)
+{
+    if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+    {
+        PostImportHandle = ImportSubsystem->OnAssetPostImport.AddRaw(this, &FBatchToolsIngestWatcher::OnAssetPostImport);
+        ReimportHandle = ImportSubsystem->OnAssetReimport.AddRaw(this, &FBatchToolsIngestWatcher::OnAssetReimport);
+    }
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBatchToolsIngestWatcher::Tick), 0.25f);
+
+    UE_LOG(LogBatchTools, Log, TEXT("Ingest watcher enabled: %s to %dpx after %.1fs of import inactivity"), 
+           LexToString(Settings.Method), Settings.TargetResolution, Settings.CoalesceSeconds);
+}
+
+FBatchToolsIngestWatcher::~FBatchToolsIngestWatcher()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+    {
+        ImportSubsystem->OnAssetPostImport.Remove(PostImportHandle);
+        ImportSubsystem->OnAssetReimport.Remove(ReimportHandle);
+    }
+}
+
+void FBatchToolsIngestWatcher::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    Collector.AddReferencedObjects(Batch.OptimizedTextures);
+    for (FPendingCookSize& Pending : Batch.PendingCookSizes)
+        Collector.AddReferencedObject(Pending.Texture);
+}
+
+void FBatchToolsIngestWatcher::OnAssetPostImport(UFactory* Factory, UObject* CreatedObject)
+{
+    Enqueue(CreatedObject);
+}
+
+void FBatchToolsIngestWatcher::OnAssetReimport(UObject* ReimportedObject)
+{
+    Enqueue(ReimportedObject);
+}
+
+void FBatchToolsIngestWatcher::Enqueue(UObject* Object)
+{
+    // Keep this cheap: it runs once per file inside the importer
+    UTexture* Texture = Cast<UTexture>(Object);
+    if (!Texture || bProcessing)
+        return;
+
+    LastImportTime = FPlatformTime::Seconds();
+
+    bool bAlreadyQueued = false;
+    PendingKeys.Add(FObjectKey(Texture), &bAlreadyQueued);
+    if (!bAlreadyQueued)
+    {
+        PendingTextures.Add(Texture);
+    }
+}
+
+bool FBatchToolsIngestWatcher::Tick(float DeltaTime)
+{
+    if (PendingTextures.Num() == 0)
+        return true;
+
+    // Wait for the burst to end and for any import dialog to close
+    if (FPlatformTime::Seconds() - LastImportTime < Settings.CoalesceSeconds || GIsSlowTask || (GEditor && GEditor->IsPlaySessionInProgress()))
+        return true;
+
+    TGuardValue<bool> ProcessingGuard(bProcessing, true);
+
+    const double EndTime = FPlatformTime::Seconds() + Settings.TimeBudgetMs / 1000.0;
+    const FBatchToolsPolicy& Policy = FBatchToolsPolicy::Get();
+
+    int32 NumConsumed = 0;
+    while (NumConsumed < PendingTextures.Num() && FPlatformTime::Seconds() < EndTime)
+    {
+        TWeakObjectPtr<UTexture> WeakTexture = PendingTextures[NumConsumed++];
+        UTexture* Texture = WeakTexture.Get();
+        if (!Texture)
+            continue;
+
+        PendingKeys.Remove(FObjectKey(Texture));
+
+        const FTexturePolicyDecision Decision = Policy.Evaluate(FAssetData(Texture));
+        if (Decision.bSkip)
+            continue;
+
+        // Max in-game size builds wait for the end of the burst, so a slice stays within its time budget
+        Module.AddToTextureBatch(Batch, Texture, Decision, Settings.Method, Settings.TargetResolution);
+    }
+
+    PendingTextures.RemoveAt(0, NumConsumed, EAllowShrinking::No);
+    if (PendingTextures.Num() == 0)
+    {
+        PendingKeys.Reset();
+    }
+
+    if (PendingTextures.Num() == 0 && !Batch.Results.IsEmpty())
+    {
+        Module.FinishTextureBatch(Batch);
+
+        // Counted after the batch is finished, since max in-game size rows are only final then
+        const FTextureOptimizationTotals Totals = Batch.Results.ComputeTotals();
+        FNotificationInfo Info(FText::Format(
+            LOCTEXT("IngestNotification", "Batch Tools ingest: {0}/{1} imported textures optimized, {2}MB VRAM saved"),
+            FText::AsNumber(Totals.NumSuccessful),
+            FText::AsNumber(Totals.NumRows),
+            FText::AsNumber(FMath::RoundToInt(Totals.VRAMSavedMB))
+        ));
+        Info.ExpireDuration = 5.0f;
+        FSlateNotificationManager::Get().AddNotification(Info);
+
+        UE_LOG(LogBatchTools, Log, TEXT("Ingest burst done: %d/%d textures optimized, %dMB VRAM saved"), 
+               Totals.NumSuccessful, Totals.NumRows, FMath::RoundToInt(Totals.VRAMSavedMB));
+
+        Batch = FTextureBatch();
+    }
+
+    return true;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,365 @@
+#include "BatchToolsMeshOptimizer.h"
+#include "BatchToolsModule.h"
+#include "BatchToolsPolicy.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+#include "StaticMeshCompiler.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/ScopedSlowTask.h"
+
+#define LOCTEXT_NAMESPACE "FBatchToolsModule"
+
+bool FMeshFolderBudget::Parse(const FString& BudgetText, FMeshFolderBudget& OutBudget)
+{
+    OutBudget = FMeshFolderBudget();
+    const TCHAR* Stream = *BudgetText;
+
+    if (!FParse::Value(Stream, TEXT("Path="), OutBudget.Path) || OutBudget.Path.IsEmpty())
+        return false;
+    OutBudget.Path.RemoveFromEnd(TEXT("/"));
+
+    FParse::Value(Stream, TEXT("MaxTriangles="), OutBudget.MaxTriangles);
+    FParse::Value(Stream, TEXT("MaxMemoryMB="), OutBudget.MaxMemoryMB);
+    OutBudget.MaxTriangles = FMath::Max<int64>(0, OutBudget.MaxTriangles);
+    OutBudget.MaxMemoryMB = FMath::Max(0.0f, OutBudget.MaxMemoryMB);
+
+    return OutBudget.MaxTriangles > 0 || OutBudget.MaxMemoryMB > 0.0f;
+}
+
+FBatchToolsMeshSettings FBatchToolsMeshSettings::Load()
+{
+    const TCHAR* Section = TEXT("BatchTools.Mesh");
+    const FString& ConfigFilename = FBatchToolsModule::GetConfigFilename();
+
+    FBatchToolsMeshSettings Settings;
+    GConfig->GetInt(Section, TEXT("NumLODs"), Settings.NumLODs, ConfigFilename);
+    GConfig->GetFloat(Section, TEXT("LODReduction"), Settings.LODReduction, ConfigFilename);
+    GConfig->GetFloat(Section, TEXT("MinPercentTriangles"), Settings.MinPercentTriangles, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MinTriangles"), Settings.MinTriangles, ConfigFilename);
+
+    TArray<FString> BudgetStrings;
+    GConfig->GetArray(Section, TEXT("Budgets"), BudgetStrings, ConfigFilename);
+    for (const FString& BudgetString : BudgetStrings)
+    {
+        FMeshFolderBudget Budget;
+        if (FMeshFolderBudget::Parse(BudgetString, Budget))
+            Settings.Budgets.Add(MoveTemp(Budget));
+        else
+            UE_LOG(LogBatchTools, Warning, TEXT("Ignoring mesh budget without a path or limit: %s"), *BudgetString);
+    }
+
+    Settings.NumLODs = FMath::Clamp(Settings.NumLODs, 1, MAX_STATIC_MESH_LODS);
+    Settings.LODReduction = FMath::Clamp(Settings.LODReduction, 0.05f, 1.0f);
+    Settings.MinPercentTriangles = FMath::Clamp(Settings.MinPercentTriangles, 0.01f, 1.0f);
+    Settings.MinTriangles = FMath::Max(0, Settings.MinTriangles);
+    return Settings;
+}
+
+const FMeshFolderBudget* FBatchToolsMeshSettings::FindBudget(FName PackagePath) const
+{
+    const FString Path = PackagePath.ToString();
+    const FMeshFolderBudget* Best = nullptr;
+
+    for (const FMeshFolderBudget& Budget : Budgets)
+    {
+        const bool bContains = Path.StartsWith(Budget.Path) && (Path.Len() == Budget.Path.Len() || Path[Budget.Path.Len()] == TEXT('/'));
+        if (bContains && (!Best || Budget.Path.Len() > Best->Path.Len()))
+            Best = &Budget;
+    }
+    return Best;
+}
+
+FBatchToolsMeshOptimizer::FMeshStats FBatchToolsMeshOptimizer::GatherStats(UStaticMesh* Mesh)
+{
+    FMeshStats Stats;
+    const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+    if (RenderData && RenderData->LODResources.Num() > 0)
+    {
+        const FStaticMeshLODResources& LOD0 = RenderData->LODResources[0];
+        Stats.Vertices = LOD0.GetNumVertices();
+        Stats.Indices = LOD0.IndexBuffer.GetNumIndices();
+        Stats.Triangles = LOD0.GetNumTriangles();
+        Stats.LOD0Bytes = LOD0.GetResourceSizeBytes();
+    }
+    Stats.Bytes = Mesh->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+    return Stats;
+}
+
+float FBatchToolsMeshOptimizer::GeneratedLODShare(UStaticMesh* Mesh, const FBatchToolsMeshSettings& Settings)
+{
+    if (Mesh->IsNaniteEnabled())
+        return 0.0f;
+
+    // Matches the generated LOD percentages in ApplyReduction, relative to the reduced LOD0
+    float Share = 0.0f;
+    for (int32 LODIndex = Mesh->GetNumSourceModels(); LODIndex < Settings.NumLODs; LODIndex++)
+        Share += FMath::Pow(Settings.LODReduction, (float)LODIndex);
+    return Share;
+}
+
+EOptimizationMethod FBatchToolsMeshOptimizer::ApplyReduction(UStaticMesh* Mesh, float TriangleScale, const FMeshStats& Stats, const FBatchToolsMeshSettings& Settings)
+{
+    Mesh->Modify();
+
+    if (Mesh->IsNaniteEnabled())
+    {
+        // The fallback is what non-Nanite platforms, raytracing and collision queries pay for
+        FMeshNaniteSettings& NaniteSettings = Mesh->NaniteSettings;
+        const float CurrentPercent = NaniteSettings.FallbackTarget == ENaniteFallbackTarget::PercentTriangles
+            ? NaniteSettings.FallbackPercentTriangles
+            : (float)Stats.Triangles / (float)FMath::Max(1, Mesh->GetNumNaniteTriangles());
+
+        NaniteSettings.FallbackTarget = ENaniteFallbackTarget::PercentTriangles;
+        NaniteSettings.FallbackPercentTriangles = FMath::Clamp(CurrentPercent * TriangleScale, Settings.MinPercentTriangles, 1.0f);
+        return EOptimizationMethod::NaniteFallback;
+    }
+
+    FStaticMeshSourceModel& BaseModel = Mesh->GetSourceModel(0);
+    const float BasePercent = FMath::Clamp(BaseModel.ReductionSettings.PercentTriangles * TriangleScale, Settings.MinPercentTriangles, 1.0f);
+    BaseModel.ReductionSettings.TerminationCriterion = EStaticMeshReductionTerimationCriterion::Triangles;
+    BaseModel.ReductionSettings.PercentTriangles = BasePercent;
+
+    // Generated LODs reduce from LOD0; imported LODs are kept as they are
+    const int32 NumExistingLODs = Mesh->GetNumSourceModels();
+    if (NumExistingLODs < Settings.NumLODs)
+    {
+        Mesh->SetNumSourceModels(Settings.NumLODs);
+        for (int32 LODIndex = NumExistingLODs; LODIndex < Settings.NumLODs; LODIndex++)
+        {
+            FStaticMeshSourceModel& Model = Mesh->GetSourceModel(LODIndex);
+            Model.ReductionSettings.TerminationCriterion = EStaticMeshReductionTerimationCriterion::Triangles;
+            Model.ReductionSettings.PercentTriangles = BasePercent * FMath::Pow(Settings.LODReduction, (float)LODIndex);
+            Model.ReductionSettings.BaseLODModel = 0;
+        }
+        Mesh->bAutoComputeLODScreenSize = true;
+    }
+
+    return EOptimizationMethod::MeshLODs;
+}
+
+FTextureOptimizationResultTable FBatchToolsMeshOptimizer::Run(const TArray<FAssetData>& Meshes, const FBatchToolsMeshSettings& Settings)
+{
+    FTextureOptimizationResultTable Results;
+    if (Meshes.Num() == 0)
+        return Results;
+
+    FScopedSlowTask SlowTask(3.0f, LOCTEXT("OptimizingMeshes", "Optimizing Static Meshes..."));
+    SlowTask.MakeDialog();
+
+    const TArray<FTexturePolicyDecision> Decisions = FBatchToolsPolicy::Get().EvaluateBatch(Meshes);
+
+    TArray<FTextureOptimizationResult> Rows;
+    TArray<UStaticMesh*> LoadedMeshes;
+    TArray<int32> RowMeshes;
+    Rows.SetNum(Meshes.Num());
+    RowMeshes.Init(INDEX_NONE, Meshes.Num());
+
+    SlowTask.EnterProgressFrame(1.0f, LOCTEXT("LoadingMeshes", "Loading meshes..."));
+    for (int32 Index = 0; Index < Meshes.Num(); Index++)
+    {
+        FTextureOptimizationResult& Row = Rows[Index];
+        Row.TextureName = Meshes[Index].AssetName;
+        Row.PackageName = Meshes[Index].PackageName;
+        Row.AssetKind = EBatchAssetKind::StaticMesh;
+        Row.MethodUsed = EOptimizationMethod::MeshLODs;
+
+        if (Decisions[Index].bSkip)
+        {
+            Row.Error = EOptimizationError::SkippedByPolicy;
+            continue;
+        }
+
+        if (UStaticMesh* Mesh = Cast<UStaticMesh>(Meshes[Index].GetAsset()))
+        {
+            RowMeshes[Index] = LoadedMeshes.Add(Mesh);
+        }
+        else
+        {
+            Row.Error = EOptimizationError::LoadFailed;
+        }
+    }
+
+    // Meshes loaded above may still be compiling, and their numbers are only final after that
+    FStaticMeshCompilingManager::Get().FinishCompilation(LoadedMeshes);
+
+    TArray<FMeshStats> BeforeStats;
+    BeforeStats.Reserve(LoadedMeshes.Num());
+    for (UStaticMesh* Mesh : LoadedMeshes)
+        BeforeStats.Add(GatherStats(Mesh));
+
+    // Budget totals; meshes below MinTriangles count against the budget but are never reduced
+    struct FBudgetGroup
+    {
+        int64 ReducibleTriangles = 0;
+        int64 FixedTriangles = 0;
+        int64 ReducibleBytes = 0;
+        int64 FixedBytes = 0;
+        // LODs the reduction would generate, estimated from LOD0 before scaling
+        int64 GeneratedBytes = 0;
+        float TriangleScale = 1.0f;
+
+        // Measured again after the build
+        int64 FinalTriangles = 0;
+        int64 FinalBytes = 0;
+        bool bOverBudget = false;
+    };
+    TMap<const FMeshFolderBudget*, FBudgetGroup> Groups;
+    TArray<const FMeshFolderBudget*> RowBudgets;
+    RowBudgets.Init(nullptr, Meshes.Num());
+
+    for (int32 Index = 0; Index < Meshes.Num(); Index++)
+    {
+        if (RowMeshes[Index] == INDEX_NONE)
+            continue;
+
+        const FMeshFolderBudget* Budget = Settings.FindBudget(Meshes[Index].PackagePath);
+        RowBudgets[Index] = Budget;
+        if (!Budget)
+            continue;
+
+        const FMeshStats& Stats = BeforeStats[RowMeshes[Index]];
+        FBudgetGroup& Group = Groups.FindOrAdd(Budget);
+        const bool bReducible = (int32)Stats.Triangles >= Settings.MinTriangles;
+        (bReducible ? Group.ReducibleTriangles : Group.FixedTriangles) += Stats.Triangles;
+        (bReducible ? Group.ReducibleBytes : Group.FixedBytes) += Stats.Bytes;
+        if (bReducible)
+            Group.GeneratedBytes += (int64)((double)Stats.LOD0Bytes * GeneratedLODShare(LoadedMeshes[RowMeshes[Index]], Settings));
+    }
+
+    for (TPair<const FMeshFolderBudget*, FBudgetGroup>& Item : Groups)
+    {
+        const FMeshFolderBudget& Budget = *Item.Key;
+        FBudgetGroup& Group = Item.Value;
+
+        if (Budget.MaxTriangles > 0 && Group.ReducibleTriangles > 0 && Group.FixedTriangles + Group.ReducibleTriangles > Budget.MaxTriangles)
+        {
+            const double Available = FMath::Max<double>(0.0, (double)(Budget.MaxTriangles - Group.FixedTriangles));
+            Group.TriangleScale = FMath::Min(Group.TriangleScale, (float)(Available / (double)Group.ReducibleTriangles));
+        }
+
+        // Vertex and index memory scale roughly with the triangle count. Reduced meshes also get
+        // generated LODs, which scale with LOD0 and count against the budget as well.
+        const int64 MaxBytes = (int64)(Budget.MaxMemoryMB * 1024.0f * 1024.0f);
+        const int64 ScaledBytes = Group.ReducibleBytes + Group.GeneratedBytes;
+        const bool bReducing = Group.TriangleScale < 1.0f;
+        if (MaxBytes > 0 && ScaledBytes > 0 && Group.FixedBytes + (bReducing ? ScaledBytes : Group.ReducibleBytes) > MaxBytes)
+        {
+            const double Available = FMath::Max<double>(0.0, (double)(MaxBytes - Group.FixedBytes));
+            Group.TriangleScale = FMath::Min(Group.TriangleScale, (float)(Available / (double)ScaledBytes));
+        }
+
+        UE_LOG(LogBatchTools, Log, TEXT("Mesh budget %s: %lld triangles, %.1fMB -> scale %.2f"), *Budget.Path,
+               Group.FixedTriangles + Group.ReducibleTriangles, (double)(Group.FixedBytes + Group.ReducibleBytes) / (1024.0 * 1024.0), Group.TriangleScale);
+    }
+
+    SlowTask.EnterProgressFrame(1.0f, LOCTEXT("ApplyingMeshSettings", "Applying reduction settings..."));
+    TArray<UStaticMesh*> MeshesToBuild;
+    TArray<int32> BuiltMeshIndices;
+    for (int32 Index = 0; Index < Meshes.Num(); Index++)
+    {
+        if (RowMeshes[Index] == INDEX_NONE)
+            continue;
+
+        FTextureOptimizationResult& Row = Rows[Index];
+        UStaticMesh* Mesh = LoadedMeshes[RowMeshes[Index]];
+        const FMeshStats& Stats = BeforeStats[RowMeshes[Index]];
+        const FBudgetGroup* Group = RowBudgets[Index] ? Groups.Find(RowBudgets[Index]) : nullptr;
+        Row.MethodUsed = Mesh->IsNaniteEnabled() ? EOptimizationMethod::NaniteFallback : EOptimizationMethod::MeshLODs;
+
+        if (!Group)
+        {
+            Row.Error = EOptimizationError::NoBudget;
+            continue;
+        }
+        if (Group->TriangleScale >= 1.0f)
+        {
+            Row.Error = EOptimizationError::WithinBudget;
+            continue;
+        }
+        if ((int32)Stats.Triangles < Settings.MinTriangles)
+        {
+            Row.Error = EOptimizationError::AlreadyAtTarget;
+            continue;
+        }
+
+        Row.MethodUsed = ApplyReduction(Mesh, Group->TriangleScale, Stats, Settings);
+        MeshesToBuild.Add(Mesh);
+        BuiltMeshIndices.Add(RowMeshes[Index]);
+    }
+
+    // One batched build; the static mesh compiler runs the builds in parallel
+    SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("BuildingMeshes", "Building {0} meshes..."), FText::AsNumber(MeshesToBuild.Num())));
+    if (MeshesToBuild.Num() > 0)
+    {
+        UStaticMesh::BatchBuild(MeshesToBuild);
+        FStaticMeshCompilingManager::Get().FinishCompilation(MeshesToBuild);
+        for (UStaticMesh* Mesh : MeshesToBuild)
+            Mesh->MarkPackageDirty();
+    }
+
+    TArray<FMeshStats> AfterStats = BeforeStats;
+    for (int32 MeshIndex : BuiltMeshIndices)
+        AfterStats[MeshIndex] = GatherStats(LoadedMeshes[MeshIndex]);
+
+    // Bytes only roughly follow the triangle scale (Nanite data, newly generated LODs), so the
+    // budgets are checked against the rebuilt meshes
+    for (int32 Index = 0; Index < Meshes.Num(); Index++)
+    {
+        if (RowMeshes[Index] == INDEX_NONE || !RowBudgets[Index])
+            continue;
+
+        FBudgetGroup& Group = Groups.FindChecked(RowBudgets[Index]);
+        Group.FinalTriangles += AfterStats[RowMeshes[Index]].Triangles;
+        Group.FinalBytes += AfterStats[RowMeshes[Index]].Bytes;
+    }
+
+    for (TPair<const FMeshFolderBudget*, FBudgetGroup>& Item : Groups)
+    {
+        const FMeshFolderBudget& Budget = *Item.Key;
+        FBudgetGroup& Group = Item.Value;
+        const int64 MaxBytes = (int64)(Budget.MaxMemoryMB * 1024.0f * 1024.0f);
+        const bool bOverTriangles = Budget.MaxTriangles > 0 && Group.FinalTriangles > Budget.MaxTriangles;
+        const bool bOverMemory = MaxBytes > 0 && Group.FinalBytes > MaxBytes;
+        Group.bOverBudget = bOverTriangles || bOverMemory;
+
+        if (Group.bOverBudget)
+        {
+            UE_LOG(LogBatchTools, Warning, TEXT("Mesh budget %s still exceeded after the build: %lld triangles (%lld over), %.1fMB (%.1fMB over)"), *Budget.Path,
+                   Group.FinalTriangles, FMath::Max<int64>(0, Budget.MaxTriangles > 0 ? Group.FinalTriangles - Budget.MaxTriangles : 0),
+                   (double)Group.FinalBytes / (1024.0 * 1024.0), (double)FMath::Max<int64>(0, MaxBytes > 0 ? Group.FinalBytes - MaxBytes : 0) / (1024.0 * 1024.0));
+        }
+    }
+
+    Results.Reserve(Rows.Num());
+    for (int32 Index = 0; Index < Rows.Num(); Index++)
+    {
+        FTextureOptimizationResult& Row = Rows[Index];
+        if (RowMeshes[Index] != INDEX_NONE)
+        {
+            const FMeshStats& Before = BeforeStats[RowMeshes[Index]];
+            const FMeshStats& After = AfterStats[RowMeshes[Index]];
+            const FBudgetGroup* Group = RowBudgets[Index] ? Groups.Find(RowBudgets[Index]) : nullptr;
+
+            Row.OriginalVertices = Before.Vertices;
+            Row.FinalVertices = After.Vertices;
+            Row.OriginalIndices = Before.Indices;
+            Row.FinalIndices = After.Indices;
+            Row.OriginalBytes = Before.Bytes;
+            Row.FinalBytes = After.Bytes;
+            Row.VRAMSavedMB = (float)((double)(Before.Bytes - After.Bytes) / (1024.0 * 1024.0));
+            Row.bSuccess = Row.Error == EOptimizationError::None;
+
+            // Every mesh of a folder that is still over budget carries the shortfall, reduced or not
+            if (Group && Group->bOverBudget)
+            {
+                Row.bOverBudget = true;
+                Row.Error = EOptimizationError::StillOverBudget;
+            }
+        }
+        Results.Add(Row);
+    }
+
+    return Results;
+}
+
+#undef LOCTEXT_NAMESPACE
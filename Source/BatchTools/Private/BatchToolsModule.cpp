@@ -1,4 +1,17 @@
 #include "BatchToolsModule.h"
+#include "BatchToolsStreamingSimulator.h"
+#include "BatchToolsPolicy.h"
+#include "BatchToolsIngestWatcher.h"
+#include "BatchToolsTextureIndex.h"
+#include "BatchToolsShardCoordinator.h"
+#include "BatchToolsDDCPrewarmer.h"
+#include "BatchToolsAtlasBuilder.h"
+#include "BatchToolsSourceProxyCache.h"
+#include "BatchToolsStreamingTelemetry.h"
+#include "BatchToolsMeshOptimizer.h"
+#include "BatchToolsAudioOptimizer.h"
+#include "BatchToolsBudgetTree.h"
+#include "SBatchToolsDashboard.h"
 #include "ContentBrowserModule.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "Framework/Notifications/NotificationManager.h"
@@ -6,6 +19,8 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/Texture.h"
 #include "Engine/Texture2D.h"
+#include "Engine/StaticMesh.h"
+#include "Sound/SoundWave.h"
 #include "UObject/UObjectIterator.h"
 #include "Misc/ScopedSlowTask.h"
 #include "Framework/Application/SlateApplication.h"
@@ -14,9 +29,22 @@
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STableRow.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/FileHelper.h"
 #include "EditorFramework/AssetImportData.h"
+#include "TextureCompiler.h"
+#include "ScopedTransaction.h"
+#include "ImageCore.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/CoreDelegates.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+#include "DesktopPlatformModule.h"
+#include "IDesktopPlatform.h"
 
 #define LOCTEXT_NAMESPACE "FBatchToolsModule"
 
@@ -24,6 +52,48 @@ DEFINE_LOG_CATEGORY(LogBatchTools);
 
 IMPLEMENT_MODULE(FBatchToolsModule, BatchTools)
 
+static const FName BatchToolsDashboardTabName(TEXT("BatchToolsDashboard"));
+
+const TCHAR* LexToString(EOptimizationMethod Method)
+{
+    switch (Method)
+    {
+        case EOptimizationMethod::LODBiasOnly:
+            return TEXT("LODBias");
+        case EOptimizationMethod::ReimportOnly:
+            return TEXT("Reimport");
+        case EOptimizationMethod::SmartAuto:
+            return TEXT("Smart");
+        case EOptimizationMethod::MaxInGameSize:
+            return TEXT("MaxSize");
+        case EOptimizationMethod::MeshLODs:
+            return TEXT("MeshLODs");
+        case EOptimizationMethod::NaniteFallback:
+            return TEXT("NaniteFallback");
+        case EOptimizationMethod::AudioCompression:
+            return TEXT("Audio");
+        default:
+            break;
+    }
+    return TEXT("Unknown");
+}
+
+bool LexTryParseString(EOptimizationMethod& OutMethod, const TCHAR* Buffer)
+{
+    const FString Value(Buffer);
+    if (Value.Equals(TEXT("LODBias")) || Value.Equals(TEXT("LODBiasOnly")))
+        OutMethod = EOptimizationMethod::LODBiasOnly;
+    else if (Value.Equals(TEXT("Reimport")) || Value.Equals(TEXT("ReimportOnly")))
+        OutMethod = EOptimizationMethod::ReimportOnly;
+    else if (Value.Equals(TEXT("Smart")) || Value.Equals(TEXT("SmartAuto")) || Value.Equals(TEXT("Hybrid")))
+        OutMethod = EOptimizationMethod::SmartAuto;
+    else if (Value.Equals(TEXT("MaxSize")) || Value.Equals(TEXT("MaxInGameSize")))
+        OutMethod = EOptimizationMethod::MaxInGameSize;
+    else
+        return false;
+    return true;
+}
+
 // Commands Implementation
 FBatchToolsCommands::FBatchToolsCommands()
     : TCommands<FBatchToolsCommands>(TEXT("BatchTools"), NSLOCTEXT("Contexts", "BatchTools", "Batch Tools"), NAME_None, TEXT("EditorStyle"))
@@ -36,24 +106,116 @@ void FBatchToolsCommands::RegisterCommands()
     UI_COMMAND(HybridOptimize, "Hybrid Optimize", "Use best method for each texture", EUserInterfaceActionType::Button, FInputChord());
     UI_COMMAND(LODBiasOptimize, "Quick Test (LOD Bias)", "Fast and reversible optimization", EUserInterfaceActionType::Button, FInputChord());
     UI_COMMAND(ReimportOptimize, "Maximum Optimize (Reimport)", "Best optimization, requires source files", EUserInterfaceActionType::Button, FInputChord());
+    UI_COMMAND(MaxSizeOptimize, "Cook Size (Max In-Game Size)", "Top mips are not cooked, shrinks packaged builds", EUserInterfaceActionType::Button, FInputChord());
 }
 
 void FBatchToolsModule::StartupModule()
 {
     UE_LOG(LogBatchTools, Log, TEXT("BatchTools Universal module starting up"));
     
+    FBatchToolsPolicy::Reload();
+    
     FBatchToolsCommands::Register();
     RegisterMenuExtensions();
+    
+    FCoreDelegates::OnPostEngineInit.AddRaw(this, &FBatchToolsModule::OnPostEngineInit);
+    
+    FGlobalTabmanager::Get()->RegisterNomadTabSpawner(BatchToolsDashboardTabName, FOnSpawnTab::CreateRaw(this, &FBatchToolsModule::SpawnDashboardTab))
+        .SetDisplayName(LOCTEXT("DashboardTabTitle", "Texture Cost Dashboard"))
+        .SetTooltipText(LOCTEXT("DashboardTabTooltip", "Query the cost of every texture in the project without optimizing anything"))
+        .SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
+void FBatchToolsModule::OnPostEngineInit()
+{
+    // The import subsystem only exists once the editor is up
+    FBatchToolsIngestSettings IngestSettings = FBatchToolsIngestSettings::Load();
+    if (IngestSettings.bEnabled && GIsEditor && !IsRunningCommandlet())
+    {
+        IngestWatcher = MakeUnique<FBatchToolsIngestWatcher>(*this, IngestSettings);
+    }
+    
+    if (GIsEditor && !IsRunningCommandlet())
+    {
+        TextureIndex = MakeShared<FBatchToolsTextureIndex>();
+        TextureIndex->Load();
+        
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+        if (AssetRegistry.IsLoadingAssets())
+        {
+            AssetRegistry.OnFilesLoaded().AddRaw(this, &FBatchToolsModule::OnAssetRegistryFilesLoaded);
+        }
+        else
+        {
+            OnAssetRegistryFilesLoaded();
+        }
+    }
+}
+
+void FBatchToolsModule::OnAssetRegistryFilesLoaded()
+{
+    if (!TextureIndex.IsValid())
+        return;
+    
+    // Catch up with changes made while the editor was closed, or build from scratch when there is no
+    // snapshot yet, then follow registry events
+    if (TextureIndex->IsEmpty())
+    {
+        TextureIndex->Build();
+    }
+    else
+    {
+        TextureIndex->Refresh();
+    }
+    TextureIndex->StartListening();
+    TextureIndex->OnPackagesChanged().AddRaw(this, &FBatchToolsModule::OnTexturePackagesChanged);
+}
+
+TSharedRef<SDockTab> FBatchToolsModule::SpawnDashboardTab(const FSpawnTabArgs& Args)
+{
+    return SNew(SDockTab)
+        .TabRole(ETabRole::NomadTab)
+        [
+            SNew(SBatchToolsDashboard)
+            .Index(TextureIndex)
+        ];
 }
 
 void FBatchToolsModule::ShutdownModule()
 {
     UE_LOG(LogBatchTools, Log, TEXT("BatchTools Universal module shutting down"));
     
+    FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+    IngestWatcher.Reset();
+    DDCPrewarmer.Reset();
+    SourceProxyCache.Reset();
+    BudgetTree.Reset();
+    
+    if (FSlateApplication::IsInitialized())
+    {
+        FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(BatchToolsDashboardTabName);
+    }
+    
+    if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
+    {
+        FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().OnFilesLoaded().RemoveAll(this);
+    }
+    TextureIndex.Reset();
+    
     UnregisterMenuExtensions();
     FBatchToolsCommands::Unregister();
 }
 
+const FString& FBatchToolsModule::GetConfigFilename()
+{
+    static FString ConfigFilename;
+    if (ConfigFilename.IsEmpty())
+    {
+        FConfigCacheIni::LoadGlobalIniFile(ConfigFilename, TEXT("BatchTools"));
+    }
+    return ConfigFilename;
+}
+
 void FBatchToolsModule::RegisterMenuExtensions()
 {
     FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
@@ -85,27 +247,36 @@ TSharedRef<FExtender> FBatchToolsModule::OnExtendContentBrowserAssetSelectionMen
 {
     TSharedRef<FExtender> Extender = MakeShareable(new FExtender());
     
-    CachedSelectedAssets = SelectedAssets;
+    // Only textures, static meshes and sound waves are kept, in buffers that keep their allocation between menu opens
+    CachedSelectedAssets.Reset();
+    CachedSelectedMeshes.Reset();
+    CachedSelectedSounds.Reset();
     bHasAssetSelection = true;
     
-    bool bHasTextures = false;
     for (const FAssetData& Asset : SelectedAssets)
     {
         if (Asset.AssetClassPath == UTexture::StaticClass()->GetClassPathName() || 
             Asset.AssetClassPath == UTexture2D::StaticClass()->GetClassPathName())
         {
-            bHasTextures = true;
-            break;
+            CachedSelectedAssets.Add(Asset);
+        }
+        else if (Asset.AssetClassPath == UStaticMesh::StaticClass()->GetClassPathName())
+        {
+            CachedSelectedMeshes.Add(Asset);
+        }
+        else if (Asset.AssetClassPath == USoundWave::StaticClass()->GetClassPathName())
+        {
+            CachedSelectedSounds.Add(Asset);
         }
     }
     
-    if (bHasTextures)
+    if (CachedSelectedAssets.Num() > 0 || CachedSelectedMeshes.Num() > 0 || CachedSelectedSounds.Num() > 0)
     {
         Extender->AddMenuExtension(
             "GetAssetActions",
             EExtensionHook::After,
             nullptr,
-            FMenuExtensionDelegate::CreateRaw(this, &FBatchToolsModule::CreateAssetContextMenu, SelectedAssets)
+            FMenuExtensionDelegate::CreateRaw(this, &FBatchToolsModule::CreateAssetContextMenu)
         );
     }
     
@@ -125,49 +296,139 @@ TSharedRef<FExtender> FBatchToolsModule::OnExtendContentBrowserPathSelectionMenu
             "PathContextBulkOperations",
             EExtensionHook::After,
             nullptr,
-            FMenuExtensionDelegate::CreateRaw(this, &FBatchToolsModule::CreatePathContextMenu, SelectedPaths)
+            FMenuExtensionDelegate::CreateRaw(this, &FBatchToolsModule::CreatePathContextMenu)
         );
     }
     
     return Extender;
 }
 
-void FBatchToolsModule::CreateAssetContextMenu(FMenuBuilder& MenuBuilder, TArray<FAssetData> SelectedAssets)
+void FBatchToolsModule::CreateAssetContextMenu(FMenuBuilder& MenuBuilder)
+{
+    MenuBuilder.BeginSection("BatchTools", LOCTEXT("BatchToolsMenuSection", "Batch Tools - Universal Texture Optimization"));
+    {
+        if (CachedSelectedAssets.Num() > 0)
+        {
+            int32 TextureCount = CachedSelectedAssets.Num();
+            int32 TexturesWithSource = 0;
+        
+            // Resolved from registry tags so opening the menu loads nothing
+            for (const FAssetData& Asset : CachedSelectedAssets)
+            {
+                if (FBatchToolsTextureIndex::ReadAssetTags(Asset).bHasSource)
+                    TexturesWithSource++;
+            }
+        
+            FString TextureInfo = FString::Printf(TEXT("(%d textures, %d with source)"), TextureCount, TexturesWithSource);
+        
+            MenuBuilder.AddMenuEntry(
+                FText::Format(LOCTEXT("LODBiasLabel", "🧪 Universal Quick Test {0}"), FText::FromString(TextureInfo)),
+                LOCTEXT("LODBiasTooltip", "Fast and reversible - Works on ANY texture size\n• Reduces VRAM usage immediately\n• Preserves original files\n• Proportional scaling for all types"),
+                FSlateIcon(),
+                FUIAction(
+                    FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteLODBiasOptimize),
+                    FCanExecuteAction::CreateRaw(this, &FBatchToolsModule::CanExecuteOptimization)
+                )
+            );
+        
+            MenuBuilder.AddMenuEntry(
+                FText::Format(LOCTEXT("ReimportLabel", "⚡ Proportional Reimport {0}"), FText::FromString(TextureInfo)),
+                FText::Format(LOCTEXT("ReimportTooltip", "Best optimization with perfect proportions\n• Works on ANY texture size\n• Only affects {0}/{1} textures with source\n• Cannot be reverted easily"), 
+                    FText::AsNumber(TexturesWithSource), FText::AsNumber(TextureCount)),
+                FSlateIcon(),
+                FUIAction(
+                    FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteReimportOptimize),
+                    FCanExecuteAction::CreateLambda([TexturesWithSource]() { return TexturesWithSource > 0; })
+                )
+            );
+        
+            MenuBuilder.AddMenuEntry(
+                FText::Format(LOCTEXT("MaxSizeLabel", "📦 Cook Size Limit {0}"), FText::FromString(TextureInfo)),
+                LOCTEXT("MaxSizeTooltip", "Limit the cooked size of each texture\n• Top mips are not cooked at all\n• Shrinks packaged builds and patches\n• Reversible: reset Maximum Texture Size to 0"),
+                FSlateIcon(),
+                FUIAction(
+                    FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteMaxSizeOptimize),
+                    FCanExecuteAction::CreateRaw(this, &FBatchToolsModule::CanExecuteOptimization)
+                )
+            );
+        
+            MenuBuilder.AddMenuEntry(
+                FText::Format(LOCTEXT("HybridLabel", "🚀 Universal Hybrid {0}"), FText::FromString(TextureInfo)),
+                FText::Format(LOCTEXT("HybridTooltip", "Intelligent combination for all texture types\n• Reimport for {0} textures with source\n• Universal LOD for {1} textures without source\n• Perfect for mixed collections"), 
+                    FText::AsNumber(TexturesWithSource), FText::AsNumber(TextureCount - TexturesWithSource)),
+                FSlateIcon(),
+                FUIAction(
+                    FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteHybridOptimize),
+                    FCanExecuteAction::CreateRaw(this, &FBatchToolsModule::CanExecuteOptimization)
+                )
+            );
+        }
+        
+        if (CachedSelectedMeshes.Num() > 0)
+        {
+            MenuBuilder.AddMenuEntry(
+                FText::Format(LOCTEXT("MeshBudgetLabel", "🔺 Optimize Meshes to Budget ({0} static meshes)"), FText::AsNumber(CachedSelectedMeshes.Num())),
+                LOCTEXT("MeshBudgetTooltip", "Fit static meshes to their folder budgets ([BatchTools.Mesh])\n• Generates LODs or lowers the Nanite fallback\n• Only meshes in over-budget folders are reduced\n• All meshes are rebuilt in one batch"),
+                FSlateIcon(),
+                FUIAction(FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteOptimizeMeshes))
+            );
+        }
+        
+        if (CachedSelectedSounds.Num() > 0)
+        {
+            MenuBuilder.AddMenuEntry(
+                FText::Format(LOCTEXT("AudioBudgetLabel", "🔊 Optimize Sound Waves to Budget ({0} sound waves)"), FText::AsNumber(CachedSelectedSounds.Num())),
+                LOCTEXT("AudioBudgetTooltip", "Fit sound waves to the audio budget ([BatchTools.Audio])\n• Lowers sample rates the spectrum does not use\n• Lowers compression quality until the batch fits\n• Compressed data is rebuilt once for the batch"),
+                FSlateIcon(),
+                FUIAction(FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteOptimizeSounds))
+            );
+        }
+    }
+    MenuBuilder.EndSection();
+}
+
+void FBatchToolsModule::CreatePathContextMenu(FMenuBuilder& MenuBuilder)
 {
     MenuBuilder.BeginSection("BatchTools", LOCTEXT("BatchToolsMenuSection", "Batch Tools - Universal Texture Optimization"));
     {
+        TArray<FAssetData> TextureAssets = GetTexturesFromPaths(CachedSelectedPaths);
+        TArray<FTexturePolicyDecision> Decisions = FBatchToolsPolicy::Get().EvaluateBatch(TextureAssets);
+        TArray<FTextureIndexEntry> Entries;
+        Entries.Reserve(TextureAssets.Num());
         int32 TextureCount = 0;
         int32 TexturesWithSource = 0;
         
-        for (const FAssetData& Asset : SelectedAssets)
+        // Resolved from registry tags so opening the menu loads nothing
+        for (int32 AssetIndex = 0; AssetIndex < TextureAssets.Num(); AssetIndex++)
         {
-            if (Asset.AssetClassPath == UTexture::StaticClass()->GetClassPathName() || 
-                Asset.AssetClassPath == UTexture2D::StaticClass()->GetClassPathName())
-            {
-                TextureCount++;
-                if (UTexture* Texture = Cast<UTexture>(Asset.GetAsset()))
-                {
-                    if (DoesSourceFileExist(Texture))
-                        TexturesWithSource++;
-                }
-            }
+            Entries.Add(FBatchToolsTextureIndex::ReadAssetTags(TextureAssets[AssetIndex]));
+            if (Decisions[AssetIndex].bSkip)
+                continue;
+            
+            TextureCount++;
+            if (Entries[AssetIndex].bHasSource)
+                TexturesWithSource++;
         }
         
-        FString TextureInfo = FString::Printf(TEXT("(%d textures, %d with source)"), TextureCount, TexturesWithSource);
+        FString FolderInfo = FString::Printf(TEXT("(%d textures found, %d with source)"), TextureCount, TexturesWithSource);
+        if (TextureCount < TextureAssets.Num())
+        {
+            FolderInfo += FString::Printf(TEXT(" [%d excluded by policy]"), TextureAssets.Num() - TextureCount);
+        }
         
         MenuBuilder.AddMenuEntry(
-            FText::Format(LOCTEXT("LODBiasLabel", "🧪 Universal Quick Test {0}"), FText::FromString(TextureInfo)),
-            LOCTEXT("LODBiasTooltip", "Fast and reversible - Works on ANY texture size\n• Reduces VRAM usage immediately\n• Preserves original files\n• Proportional scaling for all types"),
+            FText::Format(LOCTEXT("LODBiasFolderLabel", "🧪 Universal Quick Test All {0}"), FText::FromString(FolderInfo)),
+            LOCTEXT("LODBiasFolderTooltip", "Apply Universal LOD to ALL textures in folder\n• Fast and reversible\n• Works on ANY texture size\n• Proportional scaling maintained"),
             FSlateIcon(),
             FUIAction(
                 FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteLODBiasOptimize),
-                FCanExecuteAction::CreateRaw(this, &FBatchToolsModule::CanExecuteOptimization)
+                FCanExecuteAction::CreateLambda([TextureCount]() { return TextureCount > 0; })
             )
         );
         
         MenuBuilder.AddMenuEntry(
-            FText::Format(LOCTEXT("ReimportLabel", "⚡ Proportional Reimport {0}"), FText::FromString(TextureInfo)),
-            FText::Format(LOCTEXT("ReimportTooltip", "Best optimization with perfect proportions\n• Works on ANY texture size\n• Only affects {0}/{1} textures with source\n• Cannot be reverted easily"), 
+            FText::Format(LOCTEXT("ReimportFolderLabel", "⚡ Proportional Optimize All {0}"), FText::FromString(FolderInfo)),
+            FText::Format(LOCTEXT("ReimportFolderTooltip", "Reimport ALL textures with perfect proportional scaling\n• Only affects {0}/{1} textures with source\n• Others will be skipped"), 
                 FText::AsNumber(TexturesWithSource), FText::AsNumber(TextureCount)),
             FSlateIcon(),
             FUIAction(
@@ -177,67 +438,85 @@ void FBatchToolsModule::CreateAssetContextMenu(FMenuBuilder& MenuBuilder, TArray
         );
         
         MenuBuilder.AddMenuEntry(
-            FText::Format(LOCTEXT("HybridLabel", "🚀 Universal Hybrid {0}"), FText::FromString(TextureInfo)),
-            FText::Format(LOCTEXT("HybridTooltip", "Intelligent combination for all texture types\n• Reimport for {0} textures with source\n• Universal LOD for {1} textures without source\n• Perfect for mixed collections"), 
+            FText::Format(LOCTEXT("MaxSizeFolderLabel", "📦 Cook Size Limit All {0}"), FText::FromString(FolderInfo)),
+            LOCTEXT("MaxSizeFolderTooltip", "Limit the cooked size of ALL textures in folder\n• Top mips are not cooked at all\n• Shrinks packaged builds and patches"),
+            FSlateIcon(),
+            FUIAction(
+                FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteMaxSizeOptimize),
+                FCanExecuteAction::CreateLambda([TextureCount]() { return TextureCount > 0; })
+            )
+        );
+        
+        MenuBuilder.AddMenuEntry(
+            FText::Format(LOCTEXT("HybridFolderLabel", "🚀 Universal Hybrid All {0}"), FText::FromString(FolderInfo)),
+            FText::Format(LOCTEXT("HybridFolderTooltip", "Intelligent method for each texture type\n• Proportional Reimport for {0} textures with source\n• Universal LOD for {1} textures without source"), 
                 FText::AsNumber(TexturesWithSource), FText::AsNumber(TextureCount - TexturesWithSource)),
             FSlateIcon(),
             FUIAction(
                 FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteHybridOptimize),
-                FCanExecuteAction::CreateRaw(this, &FBatchToolsModule::CanExecuteOptimization)
+                FCanExecuteAction::CreateLambda([TextureCount]() { return TextureCount > 0; })
             )
         );
-    }
-    MenuBuilder.EndSection();
-}
-
-void FBatchToolsModule::CreatePathContextMenu(FMenuBuilder& MenuBuilder, TArray<FString> SelectedPaths)
-{
-    MenuBuilder.BeginSection("BatchTools", LOCTEXT("BatchToolsMenuSection", "Batch Tools - Universal Texture Optimization"));
-    {
-        TArray<FAssetData> TextureAssets = GetTexturesFromPaths(SelectedPaths);
-        int32 TextureCount = TextureAssets.Num();
-        int32 TexturesWithSource = 0;
         
-        for (const FAssetData& AssetData : TextureAssets)
+        const FBatchToolsAtlasSettings AtlasSettings = FBatchToolsAtlasSettings::Load();
+        int32 SmallTextureCount = 0;
+        for (int32 AssetIndex = 0; AssetIndex < TextureAssets.Num(); AssetIndex++)
         {
-            if (UTexture* Texture = Cast<UTexture>(AssetData.GetAsset()))
-            {
-                if (DoesSourceFileExist(Texture))
-                    TexturesWithSource++;
-            }
+            const FTextureIndexEntry& Entry = Entries[AssetIndex];
+            if (!Decisions[AssetIndex].bSkip && Entry.Width > 0 && FMath::Max(Entry.Width, Entry.Height) <= AtlasSettings.MaxSourceSize)
+                SmallTextureCount++;
         }
         
-        FString FolderInfo = FString::Printf(TEXT("(%d textures found, %d with source)"), TextureCount, TexturesWithSource);
+        MenuBuilder.AddMenuEntry(
+            FText::Format(LOCTEXT("AtlasFolderLabel", "🧩 Build Atlases ({0} textures <= {1}px)"), FText::AsNumber(SmallTextureCount), FText::AsNumber(AtlasSettings.MaxSourceSize)),
+            LOCTEXT("AtlasFolderTooltip", "Pack small textures into shared atlases\n• Writes atlases and a UV lookup asset to an Atlases subfolder\n• Source textures are left untouched"),
+            FSlateIcon(),
+            FUIAction(
+                FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteBuildAtlases),
+                FCanExecuteAction::CreateLambda([SmallTextureCount]() { return SmallTextureCount > 1; })
+            )
+        );
         
         MenuBuilder.AddMenuEntry(
-            FText::Format(LOCTEXT("LODBiasFolderLabel", "🧪 Universal Quick Test All {0}"), FText::FromString(FolderInfo)),
-            LOCTEXT("LODBiasFolderTooltip", "Apply Universal LOD to ALL textures in folder\n• Fast and reversible\n• Works on ANY texture size\n• Proportional scaling maintained"),
+            FText::Format(LOCTEXT("TelemetryFolderLabel", "📈 Apply Streaming Telemetry... {0}"), FText::FromString(FolderInfo)),
+            LOCTEXT("TelemetryFolderTooltip", "Set LOD Bias from recorded playtest captures (CSV)\n• Drops mips no run ever requested\n• Keeps a safety margin and never lowers an existing bias"),
             FSlateIcon(),
             FUIAction(
-                FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteLODBiasOptimize),
+                FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteApplyTelemetry),
                 FCanExecuteAction::CreateLambda([TextureCount]() { return TextureCount > 0; })
             )
         );
         
+        const int32 NumFolderBudgets = FBatchToolsBudgetSettings::Load().Folders.Num();
         MenuBuilder.AddMenuEntry(
-            FText::Format(LOCTEXT("ReimportFolderLabel", "⚡ Proportional Optimize All {0}"), FText::FromString(FolderInfo)),
-            FText::Format(LOCTEXT("ReimportFolderTooltip", "Reimport ALL textures with perfect proportional scaling\n• Only affects {0}/{1} textures with source\n• Others will be skipped"), 
-                FText::AsNumber(TexturesWithSource), FText::AsNumber(TextureCount)),
+            FText::Format(LOCTEXT("FolderBudgetsLabel", "💰 Enforce Folder Budgets ({0} budgets)"), FText::AsNumber(NumFolderBudgets)),
+            LOCTEXT("FolderBudgetsTooltip", "Fit folders to the budgets in [BatchTools.Budgets]\n• Rollups include every subfolder\n• Folders inherit unused headroom from their parent\n• Only over-budget folders get a higher LOD Bias"),
             FSlateIcon(),
             FUIAction(
-                FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteReimportOptimize),
-                FCanExecuteAction::CreateLambda([TexturesWithSource]() { return TexturesWithSource > 0; })
+                FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteEnforceBudgets),
+                FCanExecuteAction::CreateLambda([NumFolderBudgets, TextureCount]() { return NumFolderBudgets > 0 && TextureCount > 0; })
             )
         );
         
+        const int32 MeshCount = GetAssetsFromPaths(CachedSelectedPaths, { UStaticMesh::StaticClass()->GetClassPathName() }).Num();
         MenuBuilder.AddMenuEntry(
-            FText::Format(LOCTEXT("HybridFolderLabel", "🚀 Universal Hybrid All {0}"), FText::FromString(FolderInfo)),
-            FText::Format(LOCTEXT("HybridFolderTooltip", "Intelligent method for each texture type\n• Proportional Reimport for {0} textures with source\n• Universal LOD for {1} textures without source"), 
-                FText::AsNumber(TexturesWithSource), FText::AsNumber(TextureCount - TexturesWithSource)),
+            FText::Format(LOCTEXT("MeshBudgetFolderLabel", "🔺 Optimize Meshes to Budget ({0} static meshes)"), FText::AsNumber(MeshCount)),
+            LOCTEXT("MeshBudgetFolderTooltip", "Fit static meshes to their folder budgets ([BatchTools.Mesh])\n• Generates LODs or lowers the Nanite fallback\n• Only meshes in over-budget folders are reduced\n• All meshes are rebuilt in one batch"),
             FSlateIcon(),
             FUIAction(
-                FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteHybridOptimize),
-                FCanExecuteAction::CreateLambda([TextureCount]() { return TextureCount > 0; })
+                FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteOptimizeMeshes),
+                FCanExecuteAction::CreateLambda([MeshCount]() { return MeshCount > 0; })
+            )
+        );
+        
+        const int32 SoundCount = GetAssetsFromPaths(CachedSelectedPaths, { USoundWave::StaticClass()->GetClassPathName() }).Num();
+        MenuBuilder.AddMenuEntry(
+            FText::Format(LOCTEXT("AudioBudgetFolderLabel", "🔊 Optimize Sound Waves to Budget ({0} sound waves)"), FText::AsNumber(SoundCount)),
+            LOCTEXT("AudioBudgetFolderTooltip", "Fit sound waves to the audio budget ([BatchTools.Audio])\n• Lowers sample rates the spectrum does not use\n• Lowers compression quality until the batch fits\n• Compressed data is rebuilt once for the batch"),
+            FSlateIcon(),
+            FUIAction(
+                FExecuteAction::CreateRaw(this, &FBatchToolsModule::ExecuteOptimizeSounds),
+                FCanExecuteAction::CreateLambda([SoundCount]() { return SoundCount > 0; })
             )
         );
     }
@@ -264,6 +543,50 @@ void FBatchToolsModule::ExecuteReimportOptimize()
     ShowResolutionDialog(EOptimizationMethod::ReimportOnly);
 }
 
+void FBatchToolsModule::ExecuteMaxSizeOptimize()
+{
+    ShowResolutionDialog(EOptimizationMethod::MaxInGameSize);
+}
+
+void FBatchToolsModule::ExecuteBuildAtlases()
+{
+    BuildAtlasesInPaths(CachedSelectedPaths);
+}
+
+void FBatchToolsModule::ExecuteApplyTelemetry()
+{
+    ApplyTelemetryInPaths(CachedSelectedPaths);
+}
+
+void FBatchToolsModule::ExecuteOptimizeMeshes()
+{
+    if (bHasAssetSelection)
+    {
+        OptimizeMeshesInAssets(CachedSelectedMeshes);
+    }
+    else
+    {
+        OptimizeMeshesInAssets(GetAssetsFromPaths(CachedSelectedPaths, { UStaticMesh::StaticClass()->GetClassPathName() }));
+    }
+}
+
+void FBatchToolsModule::ExecuteEnforceBudgets()
+{
+    EnforceBudgetsInPaths(CachedSelectedPaths);
+}
+
+void FBatchToolsModule::ExecuteOptimizeSounds()
+{
+    if (bHasAssetSelection)
+    {
+        OptimizeSoundsInAssets(CachedSelectedSounds);
+    }
+    else
+    {
+        OptimizeSoundsInAssets(GetAssetsFromPaths(CachedSelectedPaths, { USoundWave::StaticClass()->GetClassPathName() }));
+    }
+}
+
 bool FBatchToolsModule::CanExecuteOptimization() const
 {
     return (bHasAssetSelection && CachedSelectedAssets.Num() > 0) || 
@@ -282,43 +605,602 @@ void FBatchToolsModule::OptimizeTextures(EOptimizationMethod Method)
     }
 }
 
-void FBatchToolsModule::OptimizeTexturesInAssets(TArray<FAssetData> Assets, EOptimizationMethod Method, int32 TargetResolution)
+void FBatchToolsModule::OptimizeTexturesInAssets(const TArray<FAssetData>& Assets, EOptimizationMethod Method, int32 TargetResolution)
+{
+    FStreamingSimulationReport StreamingReport;
+    FTextureOptimizationResultTable Results;
+    
+    FBatchToolsShardSettings ShardSettings = FBatchToolsShardSettings::Load();
+    if (ShardSettings.NumWorkers > 1 && Assets.Num() >= ShardSettings.MinAssetsForSharding)
+    {
+        // Workers change the textures, so their mip chains are read from the registry tags first
+        TMap<FName, FStreamingSimulationTexture> StreamingTexturesByPackage;
+        StreamingTexturesByPackage.Reserve(Assets.Num());
+        for (const FAssetData& Asset : Assets)
+        {
+            StreamingTexturesByPackage.Add(Asset.PackageName, FBatchToolsStreamingSimulator::GatherTextureFromTags(Asset));
+        }
+        
+        Results = FBatchToolsShardCoordinator::Run(Assets, Method, TargetResolution, ShardSettings.NumWorkers, ShardSettings.ShardsPerWorker);
+        
+        TArray<FStreamingSimulationTexture> StreamingTextures;
+        StreamingTextures.Reserve(Results.Num());
+        for (int32 Row = 0; Row < Results.Num(); Row++)
+        {
+            FStreamingSimulationTexture& StreamingTexture = StreamingTextures.AddDefaulted_GetRef();
+            if (const FStreamingSimulationTexture* Tagged = StreamingTexturesByPackage.Find(Results.GetPackageName(Row)))
+            {
+                StreamingTexture = *Tagged;
+            }
+            
+            // Same 1 byte per pixel fallback as GatherTexture when the tags have no size
+            if (StreamingTexture.MipSizes.Num() == 0)
+            {
+                StreamingTexture.Width = Results.GetOriginalWidth(Row);
+                StreamingTexture.Height = Results.GetOriginalHeight(Row);
+                StreamingTexture.MipSizes = FBatchToolsStreamingSimulator::BuildMipSizes(StreamingTexture.Width, StreamingTexture.Height, 1.0);
+            }
+        }
+        StreamingReport = FBatchToolsStreamingSimulator::Simulate(StreamingTextures, Results, FStreamingSimulationSettings::FromEngineDefaults());
+    }
+    else
+    {
+        Results = ProcessTextures(Assets, Method, TargetResolution, &StreamingReport);
+    }
+    
+    ShowOptimizationResults(MoveTemp(Results), StreamingReport);
+}
+
+FTextureOptimizationResultTable FBatchToolsModule::ProcessTextures(const TArray<FAssetData>& Assets, EOptimizationMethod Method, int32 TargetResolution, FStreamingSimulationReport* OutStreamingReport)
 {
     FScopedSlowTask SlowTask(Assets.Num(), LOCTEXT("OptimizingTextures", "Optimizing Textures..."));
     SlowTask.MakeDialog();
     
-    TArray<FTextureOptimizationResult> Results;
+    FTextureBatch Batch;
+    Batch.Results.Reserve(Assets.Num());
+    Batch.StreamingTextures.Reserve(Assets.Num());
     
-    for (const FAssetData& AssetData : Assets)
+    // Project rules are evaluated for the whole batch up front
+    TArray<FTexturePolicyDecision> Decisions = FBatchToolsPolicy::Get().EvaluateBatch(Assets);
+    int32 SkippedByPolicy = 0;
+    
+    for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); AssetIndex++)
     {
+        const FAssetData& AssetData = Assets[AssetIndex];
+        const FTexturePolicyDecision& Decision = Decisions[AssetIndex];
+        
         SlowTask.EnterProgressFrame(1, FText::Format(LOCTEXT("ProcessingTexture", "Processing {0}"), FText::FromName(AssetData.AssetName)));
         
+        if (Decision.bSkip)
+        {
+            SkippedByPolicy++;
+            continue;
+        }
+        
         if (AssetData.AssetClassPath == UTexture::StaticClass()->GetClassPathName() || 
             AssetData.AssetClassPath == UTexture2D::StaticClass()->GetClassPathName())
         {
             if (UTexture* Texture = Cast<UTexture>(AssetData.GetAsset()))
             {
-                FTextureOptimizationResult Result = OptimizeTexture(Texture, TargetResolution, Method);
-                Results.Add(Result);
+                AddToTextureBatch(Batch, Texture, Decision, Method, TargetResolution);
             }
         }
     }
     
-    ShowOptimizationResults(Results);
+    FinishTextureBatch(Batch, OutStreamingReport);
+    
+    if (SkippedByPolicy > 0)
+    {
+        UE_LOG(LogBatchTools, Log, TEXT("%d textures skipped by project policy"), SkippedByPolicy);
+    }
+    
+    if (SourceProxyCache.IsValid() && SourceProxyCache->GetNumHits() + SourceProxyCache->GetNumMisses() > 0)
+    {
+        UE_LOG(LogBatchTools, Log, TEXT("Source proxies this session: %d reused, %d built"), SourceProxyCache->GetNumHits(), SourceProxyCache->GetNumMisses());
+    }
+    
+    return MoveTemp(Batch.Results);
+}
+
+int32 FBatchToolsModule::AddToTextureBatch(FTextureBatch& Batch, UTexture* Texture, const FTexturePolicyDecision& Decision, EOptimizationMethod Method, int32 TargetResolution)
+{
+    // Capture the mip chain before OptimizeTexture changes it
+    Batch.StreamingTextures.Add(FBatchToolsStreamingSimulator::GatherTexture(Texture));
+    
+    const int32 NumPendingBefore = Batch.PendingCookSizes.Num();
+    const FTextureOptimizationResult Result = OptimizeTextureWithPolicy(Texture, Decision, Method, TargetResolution, &Batch.PendingCookSizes);
+    const int32 Row = Batch.Results.Add(Result);
+    if (Batch.PendingCookSizes.Num() > NumPendingBefore)
+        Batch.PendingCookSizes.Last().ResultIndex = Row;
+    if (Result.bSuccess)
+        Batch.OptimizedTextures.Add(Texture);
+    return Row;
 }
 
-void FBatchToolsModule::OptimizeTexturesInPaths(TArray<FString> Paths, EOptimizationMethod Method, int32 TargetResolution)
+void FBatchToolsModule::FinishTextureBatch(FTextureBatch& Batch, FStreamingSimulationReport* OutStreamingReport)
+{
+    FinishPendingCookSizes(Batch.PendingCookSizes, Batch.Results);
+    Batch.PendingCookSizes.Reset();
+    
+    if (FBatchToolsDDCPrewarmSettings::Load().bEnabled)
+    {
+        PrewarmDerivedData(Batch.OptimizedTextures);
+    }
+    
+    if (OutStreamingReport)
+    {
+        *OutStreamingReport = FBatchToolsStreamingSimulator::Simulate(Batch.StreamingTextures, Batch.Results, FStreamingSimulationSettings::FromEngineDefaults());
+    }
+}
+
+FTextureOptimizationResult FBatchToolsModule::OptimizeTextureWithPolicy(UTexture* Texture, const FTexturePolicyDecision& Decision, EOptimizationMethod Method, int32 TargetResolution, TArray<FPendingCookSize>* OutPendingCookSizes)
+{
+    if (Decision.bNormalMap && Texture->CompressionSettings != TC_Normalmap)
+    {
+        Texture->Modify();
+        Texture->CompressionSettings = TC_Normalmap;
+        Texture->SRGB = false;
+        Texture->PostEditChange();
+        Texture->MarkPackageDirty();
+    }
+    
+    return OptimizeTexture(Texture, Decision.ClampTarget(TargetResolution), Decision.Method.Get(Method), OutPendingCookSizes);
+}
+
+FTextureOptimizationResult FBatchToolsModule::PlanTexture(FName TextureName, int32 Width, int32 Height, bool bHasSourceFile, EOptimizationMethod Method, int32 TargetResolution)
+{
+    FTextureOptimizationResult Result;
+    Result.TextureName = TextureName;
+    Result.OriginalWidth = Width;
+    Result.OriginalHeight = Height;
+    Result.TargetResolution = TargetResolution;
+    Result.FinalWidth = Width;
+    Result.FinalHeight = Height;
+    Result.bHadSourceFile = bHasSourceFile;
+    Result.MethodUsed = ChooseOptimizationMethod(Method, bHasSourceFile);
+    
+    if (FMath::Max(Width, Height) <= TargetResolution)
+    {
+        Result.Error = EOptimizationError::AlreadyAtTarget;
+        return Result;
+    }
+    
+    if (Result.MethodUsed == EOptimizationMethod::ReimportOnly)
+    {
+        FIntPoint NewSize = CalculateProportionalSize(Width, Height, TargetResolution);
+        Result.FinalWidth = NewSize.X;
+        Result.FinalHeight = NewSize.Y;
+    }
+    else
+    {
+        int32 LodBias = CalculateUniversalLODBias(Width, Height, TargetResolution);
+        Result.FinalWidth = FMath::Max(1, Width >> LodBias);
+        Result.FinalHeight = FMath::Max(1, Height >> LodBias);
+    }
+    
+    Result.VRAMSavedMB = CalculateFileSizeMB(Width, Height) - CalculateFileSizeMB(Result.FinalWidth, Result.FinalHeight);
+    Result.bSuccess = true;
+    return Result;
+}
+
+FTextureOptimizationResultTable FBatchToolsModule::ApplyStreamingTelemetry(const TArray<FAssetData>& Assets, const FBatchToolsStreamingTelemetry& Telemetry, FStreamingSimulationReport* OutStreamingReport)
+{
+    const FBatchToolsTelemetrySettings Settings = FBatchToolsTelemetrySettings::Load();
+    const TArray<const FStreamingTelemetryEntry*> Matches = Telemetry.MatchAssets(Assets);
+    const TArray<FTexturePolicyDecision> Decisions = FBatchToolsPolicy::Get().EvaluateBatch(Assets);
+    
+    FScopedSlowTask SlowTask(Assets.Num(), LOCTEXT("ApplyingTelemetry", "Applying streaming telemetry..."));
+    SlowTask.MakeDialog();
+    
+    FTextureOptimizationResultTable Results;
+    TArray<FStreamingSimulationTexture> StreamingTextures;
+    TArray<UTexture*> OptimizedTextures;
+    int32 NumUnmatched = 0;
+    
+    for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); AssetIndex++)
+    {
+        SlowTask.EnterProgressFrame(1);
+        
+        // Only textures that appear in a capture are loaded
+        const FStreamingTelemetryEntry* Entry = Matches[AssetIndex];
+        if (!Entry)
+        {
+            NumUnmatched++;
+            continue;
+        }
+        
+        FTextureOptimizationResult Result;
+        Result.TextureName = Assets[AssetIndex].AssetName;
+        Result.PackageName = Assets[AssetIndex].PackageName;
+        Result.MethodUsed = EOptimizationMethod::LODBiasOnly;
+        
+        if (Decisions[AssetIndex].bSkip)
+        {
+            Result.Error = EOptimizationError::SkippedByPolicy;
+            StreamingTextures.AddDefaulted();
+            Results.Add(Result);
+            continue;
+        }
+        
+        UTexture* Texture = Cast<UTexture>(Assets[AssetIndex].GetAsset());
+        if (!Texture)
+        {
+            Result.Error = EOptimizationError::LoadFailed;
+            StreamingTextures.AddDefaulted();
+            Results.Add(Result);
+            continue;
+        }
+        
+        StreamingTextures.Add(FBatchToolsStreamingSimulator::GatherTexture(Texture));
+        
+        Result.OriginalWidth = Texture->GetSurfaceWidth();
+        Result.OriginalHeight = Texture->GetSurfaceHeight();
+        Result.bHadSourceFile = DoesSourceFileExist(Texture);
+        
+        const int32 LODBias = FBatchToolsStreamingTelemetry::CalculateLODBias(Result.OriginalWidth, Result.OriginalHeight, Texture->LODBias, *Entry, Settings);
+        Result.FinalWidth = FMath::Max(1, Result.OriginalWidth >> LODBias);
+        Result.FinalHeight = FMath::Max(1, Result.OriginalHeight >> LODBias);
+        
+        if (LODBias == Texture->LODBias)
+        {
+            Result.Error = EOptimizationError::TelemetryUnchanged;
+            Results.Add(Result);
+            continue;
+        }
+        
+        const int32 PreviousWidth = FMath::Max(1, Result.OriginalWidth >> Texture->LODBias);
+        const int32 PreviousHeight = FMath::Max(1, Result.OriginalHeight >> Texture->LODBias);
+        
+        Texture->Modify();
+        Texture->LODBias = LODBias;
+        Texture->PostEditChange();
+        Texture->MarkPackageDirty();
+        
+        Result.VRAMSavedMB = CalculateFileSizeMB(PreviousWidth, PreviousHeight) - CalculateFileSizeMB(Result.FinalWidth, Result.FinalHeight);
+        Result.bSuccess = true;
+        Results.Add(Result);
+        OptimizedTextures.Add(Texture);
+        
+        UE_LOG(LogBatchTools, Log, TEXT("Streaming telemetry applied to %s: max requested %dx%d over %d runs -> LOD %d (effective %dx%d)"), 
+               *Texture->GetName(), Entry->MaxRequestedWidth, Entry->MaxRequestedHeight, Entry->NumRuns, LODBias, Result.FinalWidth, Result.FinalHeight);
+    }
+    
+    if (NumUnmatched > 0)
+    {
+        UE_LOG(LogBatchTools, Log, TEXT("%d textures have no streaming telemetry and were left unchanged"), NumUnmatched);
+    }
+    
+    if (FBatchToolsDDCPrewarmSettings::Load().bEnabled)
+    {
+        PrewarmDerivedData(OptimizedTextures);
+    }
+    
+    if (OutStreamingReport)
+    {
+        *OutStreamingReport = FBatchToolsStreamingSimulator::Simulate(StreamingTextures, Results, FStreamingSimulationSettings::FromEngineDefaults());
+    }
+    
+    return Results;
+}
+
+void FBatchToolsModule::PrewarmDerivedData(const TArray<UTexture*>& Textures)
+{
+    if (Textures.Num() == 0)
+        return;
+    
+    if (!DDCPrewarmer.IsValid())
+    {
+        DDCPrewarmer = MakeUnique<FBatchToolsDDCPrewarmer>(FBatchToolsDDCPrewarmSettings::Load());
+    }
+    DDCPrewarmer->Prewarm(Textures);
+}
+
+void FBatchToolsModule::WaitForDerivedData()
+{
+    if (DDCPrewarmer.IsValid())
+    {
+        DDCPrewarmer->WaitForCompletion();
+    }
+}
+
+FTextureOptimizationResultTable FBatchToolsModule::ProcessStaticMeshes(const TArray<FAssetData>& Assets)
+{
+    const FBatchToolsMeshSettings Settings = FBatchToolsMeshSettings::Load();
+    if (Settings.Budgets.Num() == 0)
+    {
+        UE_LOG(LogBatchTools, Warning, TEXT("No mesh budgets in [BatchTools.Mesh]; every mesh is within budget"));
+    }
+    return FBatchToolsMeshOptimizer::Run(Assets, Settings);
+}
+
+void FBatchToolsModule::OptimizeMeshesInAssets(const TArray<FAssetData>& Assets)
+{
+    ShowOptimizationResults(ProcessStaticMeshes(Assets), FStreamingSimulationReport());
+}
+
+FTextureOptimizationResultTable FBatchToolsModule::ProcessSoundWaves(const TArray<FAssetData>& Assets)
+{
+    return FBatchToolsAudioOptimizer::Run(Assets, FBatchToolsAudioSettings::Load());
+}
+
+void FBatchToolsModule::OptimizeSoundsInAssets(const TArray<FAssetData>& Assets)
+{
+    ShowOptimizationResults(ProcessSoundWaves(Assets), FStreamingSimulationReport());
+}
+
+FTextureOptimizationResultTable FBatchToolsModule::EnforceFolderBudgets(const TArray<FString>& Paths)
+{
+    const FBatchToolsBudgetSettings Settings = FBatchToolsBudgetSettings::Load();
+    FTextureOptimizationResultTable Results;
+    if (Settings.Folders.Num() == 0)
+    {
+        UE_LOG(LogBatchTools, Warning, TEXT("No folder budgets in [BatchTools.Budgets]"));
+        return Results;
+    }
+    
+    // Only the first enforcement scans the registry; later ones reuse the rollups
+    if (!BudgetTree.IsValid())
+    {
+        BudgetTree = MakeUnique<FBatchToolsBudgetTree>();
+    }
+    if (!BudgetTree->IsBuilt() || BudgetTree->GetRootPath() != Settings.RootPath)
+    {
+        BudgetTree->Build(Settings);
+    }
+    else
+    {
+        BudgetTree->ApplySettings(Settings);
+    }
+    
+    struct FFolderBefore
+    {
+        int32 Folder = INDEX_NONE;
+        int64 RollupBytes = 0;
+        bool bOverBudget = false;
+    };
+    TArray<FFolderBefore> Folders;
+    for (int32 Folder : BudgetTree->GetReportedFolders(Paths))
+    {
+        Folders.Add({ Folder, BudgetTree->GetRollupBytes(Folder), BudgetTree->IsOverBudget(Folder) });
+    }
+    
+    const TArray<FBudgetReduction> Reductions = BudgetTree->PlanReductions(Paths);
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    
+    FScopedSlowTask SlowTask(Reductions.Num(), LOCTEXT("EnforcingBudgets", "Enforcing folder budgets..."));
+    SlowTask.MakeDialog();
+    
+    FTextureOptimizationResultTable TextureResults;
+    TArray<UTexture*> OptimizedTextures;
+    
+    for (const FBudgetReduction& Reduction : Reductions)
+    {
+        SlowTask.EnterProgressFrame(1);
+        
+        TArray<FAssetData> PackageAssets;
+        AssetRegistry.GetAssetsByPackageName(Reduction.PackageName, PackageAssets);
+        
+        FTextureOptimizationResult Result;
+        Result.TextureName = PackageAssets.Num() > 0 ? PackageAssets[0].AssetName : Reduction.PackageName;
+        Result.PackageName = Reduction.PackageName;
+        Result.MethodUsed = EOptimizationMethod::LODBiasOnly;
+        
+        UTexture* Texture = PackageAssets.Num() > 0 ? Cast<UTexture>(PackageAssets[0].GetAsset()) : nullptr;
+        if (!Texture)
+        {
+            Result.Error = EOptimizationError::LoadFailed;
+            TextureResults.Add(Result);
+            continue;
+        }
+        
+        Result.OriginalWidth = Texture->GetSurfaceWidth();
+        Result.OriginalHeight = Texture->GetSurfaceHeight();
+        Result.bHadSourceFile = DoesSourceFileExist(Texture);
+        
+        // The plan comes from registry tags; a texture biased further since then is left as it is
+        const int32 LODBias = FMath::Max(Texture->LODBias, Reduction.TargetLODBias);
+        Result.FinalWidth = FMath::Max(1, Result.OriginalWidth >> LODBias);
+        Result.FinalHeight = FMath::Max(1, Result.OriginalHeight >> LODBias);
+        
+        if (LODBias == Texture->LODBias)
+        {
+            Result.Error = EOptimizationError::AlreadyAtTarget;
+            TextureResults.Add(Result);
+            continue;
+        }
+        
+        const int32 PreviousWidth = FMath::Max(1, Result.OriginalWidth >> Texture->LODBias);
+        const int32 PreviousHeight = FMath::Max(1, Result.OriginalHeight >> Texture->LODBias);
+        
+        Texture->Modify();
+        Texture->LODBias = LODBias;
+        Texture->PostEditChange();
+        Texture->MarkPackageDirty();
+        
+        Result.VRAMSavedMB = CalculateFileSizeMB(PreviousWidth, PreviousHeight) - CalculateFileSizeMB(Result.FinalWidth, Result.FinalHeight);
+        Result.bSuccess = true;
+        TextureResults.Add(Result);
+        OptimizedTextures.Add(Texture);
+        
+        // Only this texture's folders up to the root are recomputed
+        BudgetTree->UpdateAsset(FAssetData(Texture));
+    }
+    
+    for (const FFolderBefore& Before : Folders)
+    {
+        FTextureOptimizationResult Result;
+        Result.TextureName = BudgetTree->GetFolderPath(Before.Folder);
+        Result.AssetKind = EBatchAssetKind::Folder;
+        Result.MethodUsed = EOptimizationMethod::LODBiasOnly;
+        Result.OriginalBytes = Before.RollupBytes;
+        Result.FinalBytes = BudgetTree->GetRollupBytes(Before.Folder);
+        Result.BudgetBytes = BudgetTree->GetTargetBytes(Before.Folder);
+        Result.bOverBudget = Before.bOverBudget;
+        Result.bSuccess = Before.bOverBudget && !BudgetTree->IsOverBudget(Before.Folder);
+        if (!Before.bOverBudget)
+        {
+            Result.Error = EOptimizationError::WithinBudget;
+        }
+        else if (!Result.bSuccess)
+        {
+            Result.Error = EOptimizationError::StillOverBudget;
+        }
+        Results.Add(Result);
+    }
+    Results.Append(TextureResults);
+    
+    UE_LOG(LogBatchTools, Log, TEXT("Folder budgets: %d folders reported, %d textures given a higher LOD bias"), Folders.Num(), OptimizedTextures.Num());
+    
+    if (FBatchToolsDDCPrewarmSettings::Load().bEnabled)
+    {
+        PrewarmDerivedData(OptimizedTextures);
+    }
+    
+    return Results;
+}
+
+void FBatchToolsModule::EnforceBudgetsInPaths(const TArray<FString>& Paths)
+{
+    ShowOptimizationResults(EnforceFolderBudgets(Paths), FStreamingSimulationReport());
+}
+
+void FBatchToolsModule::OnTexturePackagesChanged(const TArray<FName>& PackageNames)
+{
+    if (!BudgetTree.IsValid() || !BudgetTree->IsBuilt())
+        return;
+    
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    for (FName PackageName : PackageNames)
+    {
+        TArray<FAssetData> PackageAssets;
+        AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets);
+        
+        const FAssetData* TextureAsset = PackageAssets.FindByPredicate([](const FAssetData& Asset) { return Asset.IsInstanceOf(UTexture2D::StaticClass()); });
+        if (TextureAsset)
+        {
+            BudgetTree->UpdateAsset(*TextureAsset);
+        }
+        else
+        {
+            BudgetTree->RemoveAsset(PackageName);
+        }
+    }
+}
+
+void FBatchToolsModule::OptimizeTexturesInPaths(const TArray<FString>& Paths, EOptimizationMethod Method, int32 TargetResolution)
 {
     TArray<FAssetData> TextureAssets = GetTexturesFromPaths(Paths);
     OptimizeTexturesInAssets(TextureAssets, Method, TargetResolution);
 }
 
-FTextureOptimizationResult FBatchToolsModule::OptimizeTexture(UTexture* Texture, int32 TargetResolution, EOptimizationMethod Method)
+void FBatchToolsModule::BuildAtlasesInPaths(const TArray<FString>& Paths)
+{
+    if (Paths.Num() == 0)
+        return;
+    
+    const FBatchToolsAtlasSettings Settings = FBatchToolsAtlasSettings::Load();
+    TArray<FAssetData> TextureAssets = GetTexturesFromPaths(Paths);
+    TArray<FTexturePolicyDecision> Decisions = FBatchToolsPolicy::Get().EvaluateBatch(TextureAssets);
+    
+    const FString OutputFolder = Settings.OutputFolder.IsEmpty() ? Paths[0] / TEXT("Atlases") : Settings.OutputFolder;
+    
+    TArray<FBatchToolsAtlasInput> Inputs;
+    {
+        FScopedSlowTask SlowTask(TextureAssets.Num(), LOCTEXT("GatheringAtlasTextures", "Gathering small textures..."));
+        SlowTask.MakeDialog();
+        
+        for (int32 AssetIndex = 0; AssetIndex < TextureAssets.Num(); AssetIndex++)
+        {
+            SlowTask.EnterProgressFrame(1);
+            
+            const FTextureIndexEntry Entry = FBatchToolsTextureIndex::ReadAssetTags(TextureAssets[AssetIndex]);
+            if (Decisions[AssetIndex].bSkip || Entry.Width <= 0 || FMath::Max(Entry.Width, Entry.Height) > Settings.MaxSourceSize)
+                continue;
+            
+            // Normal maps and HDR data would not survive the 8-bit color atlas
+            UTexture2D* Texture = Cast<UTexture2D>(TextureAssets[AssetIndex].GetAsset());
+            if (!Texture || !Texture->Source.IsValid() || Texture->HasHDRSource() || Texture->CompressionSettings == TC_Normalmap)
+                continue;
+            
+            FIntPoint SpriteSize = CalculateProportionalSize(Texture->Source.GetSizeX(), Texture->Source.GetSizeY(), Settings.MaxSpriteSize);
+            
+            FBatchToolsAtlasInput& Input = Inputs.AddDefaulted_GetRef();
+            Input.Texture = Texture;
+            // Extreme aspect ratios must still leave one pixel to sample
+            Input.Width = FMath::Max(1, SpriteSize.X);
+            Input.Height = FMath::Max(1, SpriteSize.Y);
+            Input.ResidentBytes = Entry.ResidentBytes;
+        }
+    }
+    
+    FBatchToolsAtlasReport Report;
+    {
+        FScopedSlowTask SlowTask(1, LOCTEXT("BuildingAtlases", "Building atlases..."));
+        SlowTask.MakeDialog();
+        SlowTask.EnterProgressFrame(1);
+        Report = FBatchToolsAtlasBuilder::Build(Inputs, OutputFolder, Settings);
+    }
+    
+    const float BeforeMB = (float)Report.BeforeResidentBytes / (1024.0f * 1024.0f);
+    const float AfterMB = (float)Report.AfterResidentBytes / (1024.0f * 1024.0f);
+    
+    UE_LOG(LogBatchTools, Log, TEXT("Atlas build: %d textures -> %d atlases in %s (%d left unpacked), %.1fMB -> %.1fMB VRAM, packed in %.2fs"), 
+           Report.NumSprites, Report.NumAtlases, *OutputFolder, Report.NumUnpacked, BeforeMB, AfterMB, Report.PackSeconds);
+    
+    FNotificationInfo Info(FText::Format(
+        LOCTEXT("AtlasNotification", "Atlas build complete: {0} textures -> {1} atlases in {4}, {2}MB -> {3}MB VRAM"),
+        FText::AsNumber(Report.NumSprites),
+        FText::AsNumber(Report.NumAtlases),
+        FText::AsNumber(FMath::RoundToInt(BeforeMB)),
+        FText::AsNumber(FMath::RoundToInt(AfterMB)),
+        FText::FromString(OutputFolder)
+    ));
+    Info.ExpireDuration = 5.0f;
+    FSlateNotificationManager::Get().AddNotification(Info);
+}
+
+void FBatchToolsModule::ApplyTelemetryInPaths(const TArray<FString>& Paths)
+{
+    IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+    if (!DesktopPlatform || Paths.Num() == 0)
+        return;
+    
+    TArray<FString> CaptureFiles;
+    const bool bPicked = DesktopPlatform->OpenFileDialog(
+        FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+        LOCTEXT("TelemetryDialogTitle", "Select streaming captures").ToString(),
+        FPaths::ProjectSavedDir(),
+        TEXT(""),
+        TEXT("Streaming captures (*.csv)|*.csv"),
+        EFileDialogFlags::Multiple,
+        CaptureFiles);
+    
+    if (!bPicked || CaptureFiles.Num() == 0)
+        return;
+    
+    FBatchToolsStreamingTelemetry Telemetry;
+    Telemetry.IngestFiles(CaptureFiles);
+    if (Telemetry.NumRuns() == 0)
+    {
+        FNotificationInfo Info(LOCTEXT("TelemetryNoRuns", "No texture name and size columns found in the selected captures"));
+        Info.ExpireDuration = 5.0f;
+        FSlateNotificationManager::Get().AddNotification(Info);
+        return;
+    }
+    
+    FStreamingSimulationReport StreamingReport;
+    FTextureOptimizationResultTable Results = ApplyStreamingTelemetry(GetTexturesFromPaths(Paths), Telemetry, &StreamingReport);
+    ShowOptimizationResults(MoveTemp(Results), StreamingReport);
+}
+
+FTextureOptimizationResult FBatchToolsModule::OptimizeTexture(UTexture* Texture, int32 TargetResolution, EOptimizationMethod Method, TArray<FPendingCookSize>* OutPendingCookSizes)
 {
     FTextureOptimizationResult Result;
-    Result.TextureName = Texture->GetName();
+    Result.TextureName = Texture->GetFName();
+    Result.PackageName = Texture->GetPackage()->GetFName();
     Result.OriginalWidth = Texture->GetSurfaceWidth();
     Result.OriginalHeight = Texture->GetSurfaceHeight();
+    Result.TargetResolution = TargetResolution;
     
     bool bHasSourceFile = DoesSourceFileExist(Texture);
     Result.bHadSourceFile = bHasSourceFile;
@@ -339,6 +1221,12 @@ FTextureOptimizationResult FBatchToolsModule::OptimizeTexture(UTexture* Texture,
                 return OptimizeWithReimport(Texture, TargetResolution);
             else
                 return OptimizeWithLODBias(Texture, TargetResolution);
+            
+        case EOptimizationMethod::MaxInGameSize:
+            return OptimizeWithMaxInGameSize(Texture, TargetResolution, OutPendingCookSizes);
+            
+        default:
+            break;
     }
     
     return Result;
@@ -347,10 +1235,12 @@ FTextureOptimizationResult FBatchToolsModule::OptimizeTexture(UTexture* Texture,
 FTextureOptimizationResult FBatchToolsModule::OptimizeWithLODBias(UTexture* Texture, int32 TargetResolution)
 {
     FTextureOptimizationResult Result;
-    Result.TextureName = Texture->GetName();
+    Result.TextureName = Texture->GetFName();
+    Result.PackageName = Texture->GetPackage()->GetFName();
     Result.MethodUsed = EOptimizationMethod::LODBiasOnly;
     Result.OriginalWidth = Texture->GetSurfaceWidth();
     Result.OriginalHeight = Texture->GetSurfaceHeight();
+    Result.TargetResolution = TargetResolution;
     
     int32 MaxDim = FMath::Max(Result.OriginalWidth, Result.OriginalHeight);
     
@@ -359,8 +1249,7 @@ FTextureOptimizationResult FBatchToolsModule::OptimizeWithLODBias(UTexture* Text
         Result.FinalWidth = Result.OriginalWidth;
         Result.FinalHeight = Result.OriginalHeight;
         Result.bSuccess = false;
-        Result.ErrorMessage = FString::Printf(TEXT("Already at target size (%dx%d <= %d)"), 
-                                            Result.OriginalWidth, Result.OriginalHeight, TargetResolution);
+        Result.Error = EOptimizationError::AlreadyAtTarget;
         return Result;
     }
     
@@ -394,72 +1283,246 @@ FTextureOptimizationResult FBatchToolsModule::OptimizeWithLODBias(UTexture* Text
                    *Texture->GetName(), Result.OriginalWidth, Result.OriginalHeight, LodBias, Result.FinalWidth, Result.FinalHeight);
         }
     }
-    else
+    else
+    {
+        Result.FinalWidth = Result.OriginalWidth;
+        Result.FinalHeight = Result.OriginalHeight;
+        Result.bSuccess = false;
+        Result.Error = EOptimizationError::NoLODBias;
+    }
+    
+    return Result;
+}
+
+FTextureOptimizationResult FBatchToolsModule::OptimizeWithReimport(UTexture* Texture, int32 TargetResolution)
+{
+    FTextureOptimizationResult Result;
+    Result.TextureName = Texture->GetFName();
+    Result.PackageName = Texture->GetPackage()->GetFName();
+    Result.MethodUsed = EOptimizationMethod::ReimportOnly;
+    Result.OriginalWidth = Texture->GetSurfaceWidth();
+    Result.OriginalHeight = Texture->GetSurfaceHeight();
+    Result.TargetResolution = TargetResolution;
+    
+    if (!DoesSourceFileExist(Texture))
+    {
+        Result.bSuccess = false;
+        Result.Error = EOptimizationError::SourceFileMissing;
+        UE_LOG(LogBatchTools, Warning, TEXT("Cannot reimport %s: source file not found"), *Texture->GetName());
+        return Result;
+    }
+    
+    if (!SourceProxyCache.IsValid())
+    {
+        SourceProxyCache = MakeUnique<FBatchToolsSourceProxyCache>(FBatchToolsSourceProxySettings::Load());
+    }
+    
+    // Sizes come from the source file once it is cached, so a texture whose source was replaced
+    // can be rebuilt at a larger budget
+    FIntPoint SourceSize(Result.OriginalWidth, Result.OriginalHeight);
+    SourceProxyCache->FindSourceSize(Texture, SourceSize);
+    
+    FIntPoint NewSize = CalculateProportionalSize(SourceSize.X, SourceSize.Y, TargetResolution);
+    if (FMath::Max(SourceSize.X, SourceSize.Y) <= TargetResolution)
+    {
+        NewSize = SourceSize;
+    }
+    
+    if (NewSize == FIntPoint(Result.OriginalWidth, Result.OriginalHeight))
+    {
+        Result.FinalWidth = Result.OriginalWidth;
+        Result.FinalHeight = Result.OriginalHeight;
+        Result.bSuccess = false;
+        Result.Error = EOptimizationError::AlreadyAtTarget;
+        return Result;
+    }
+    
+    Result.FinalWidth = NewSize.X;
+    Result.FinalHeight = NewSize.Y;
+    
+    Result.VRAMSavedMB = CalculateFileSizeMB(Result.OriginalWidth, Result.OriginalHeight) - 
+                        CalculateFileSizeMB(Result.FinalWidth, Result.FinalHeight);
+    Result.FileSizeSavedMB = Result.VRAMSavedMB * 0.8f;
+    
+    // Cubemaps, arrays and UDIMs keep the calculated result only
+    const bool bCanRebuildSource = Texture->IsA<UTexture2D>() && Texture->Source.GetNumBlocks() == 1 && Texture->Source.GetNumSlices() == 1;
+    if (!bCanRebuildSource)
+    {
+        Result.bSuccess = true;
+        Result.Error = EOptimizationError::ReimportSimulated;
+        return Result;
+    }
+    
+    FImage Resampled;
+    if (!SourceProxyCache->Resample(Texture, NewSize.X, NewSize.Y, Resampled))
     {
         Result.FinalWidth = Result.OriginalWidth;
         Result.FinalHeight = Result.OriginalHeight;
+        Result.VRAMSavedMB = 0.0f;
+        Result.FileSizeSavedMB = 0.0f;
         Result.bSuccess = false;
-        Result.ErrorMessage = TEXT("Could not calculate effective LOD Bias");
+        Result.Error = EOptimizationError::SourceDecodeFailed;
+        return Result;
+    }
+    
+    const bool bWriteSource = SourceProxyCache->GetSettings().bWriteSource;
+    if (bWriteSource)
+    {
+        Result.bSuccess = true;
+        FScopedTransaction Transaction(LOCTEXT("ReplaceTextureSource", "Replace Texture Source"));
+        Texture->Modify();
+        Texture->PreEditChange(nullptr);
+        Texture->Source.Init(Resampled);
+        Texture->PostEditChange();
+        Texture->MarkPackageDirty();
+    }
+    
+    bool bIsNPOT = !IsPowerOfTwo(Result.OriginalWidth) || !IsPowerOfTwo(Result.OriginalHeight);
+    UE_LOG(LogBatchTools, Log, TEXT("Proportional reimport %s %s%s: %dx%d -> %dx%d (%s %dMB VRAM)"), 
+           bWriteSource ? TEXT("applied to") : TEXT("calculated for"), bIsNPOT ? TEXT("NPOT texture ") : TEXT(""),
+           *Texture->GetName(), Result.OriginalWidth, Result.OriginalHeight, Result.FinalWidth, Result.FinalHeight,
+           bWriteSource ? TEXT("saved") : TEXT("would save"), FMath::RoundToInt(Result.VRAMSavedMB));
+    
+    if (!bWriteSource)
+    {
+        // Trials only measure the resampled size; nothing changed, so nothing is counted as saved or prewarmed
+        Result.VRAMSavedMB = 0.0f;
+        Result.FileSizeSavedMB = 0.0f;
+        Result.Error = EOptimizationError::ReimportTrial;
     }
     
     return Result;
 }
 
-FTextureOptimizationResult FBatchToolsModule::OptimizeWithReimport(UTexture* Texture, int32 TargetResolution)
+FTextureOptimizationResult FBatchToolsModule::OptimizeWithMaxInGameSize(UTexture* Texture, int32 TargetResolution, TArray<FPendingCookSize>* OutPendingCookSizes)
 {
     FTextureOptimizationResult Result;
-    Result.TextureName = Texture->GetName();
-    Result.MethodUsed = EOptimizationMethod::ReimportOnly;
+    Result.TextureName = Texture->GetFName();
+    Result.PackageName = Texture->GetPackage()->GetFName();
+    Result.MethodUsed = EOptimizationMethod::MaxInGameSize;
     Result.OriginalWidth = Texture->GetSurfaceWidth();
     Result.OriginalHeight = Texture->GetSurfaceHeight();
+    Result.TargetResolution = TargetResolution;
+    Result.bHadSourceFile = DoesSourceFileExist(Texture);
     
-    if (!DoesSourceFileExist(Texture))
+    int32 MaxDim = FMath::Max(Result.OriginalWidth, Result.OriginalHeight);
+    
+    // An existing size limit or bias may already bring the texture to the target
+    const int32 ExistingBias = FMath::Max(0, Texture->LODBias);
+    const int32 CurrentMaxDim = FMath::Max(1, (Texture->MaxTextureSize > 0 ? FMath::Min(MaxDim, Texture->MaxTextureSize) : MaxDim) >> ExistingBias);
+    
+    if (CurrentMaxDim <= TargetResolution)
     {
+        Result.FinalWidth = Result.OriginalWidth;
+        Result.FinalHeight = Result.OriginalHeight;
         Result.bSuccess = false;
-        Result.ErrorMessage = TEXT("Source file not found - cannot reimport");
-        UE_LOG(LogBatchTools, Warning, TEXT("Cannot reimport %s: source file not found"), *Texture->GetName());
+        Result.Error = EOptimizationError::AlreadyAtTarget;
         return Result;
     }
     
-    int32 MaxDim = FMath::Max(Result.OriginalWidth, Result.OriginalHeight);
+    // Same mip count as the LOD bias path, but applied at cook time
+    int32 LodBias = CalculateUniversalLODBias(Result.OriginalWidth, Result.OriginalHeight, TargetResolution);
     
-    if (MaxDim <= TargetResolution)
+    if (LodBias <= 0)
     {
         Result.FinalWidth = Result.OriginalWidth;
         Result.FinalHeight = Result.OriginalHeight;
         Result.bSuccess = false;
-        Result.ErrorMessage = FString::Printf(TEXT("Already at target size (%dx%d <= %d)"), 
-                                            Result.OriginalWidth, Result.OriginalHeight, TargetResolution);
+        Result.Error = EOptimizationError::NoLODBias;
         return Result;
     }
     
-    FIntPoint NewSize = CalculateProportionalSize(Result.OriginalWidth, Result.OriginalHeight, TargetResolution);
-    Result.FinalWidth = NewSize.X;
-    Result.FinalHeight = NewSize.Y;
+    // The existing bias is kept and still drops its mips at runtime, so the cook limit only removes the rest
+    const int32 CookSteps = LodBias - ExistingBias;
+    if (CookSteps <= 0)
+    {
+        Result.FinalWidth = Result.OriginalWidth;
+        Result.FinalHeight = Result.OriginalHeight;
+        Result.bSuccess = false;
+        Result.Error = EOptimizationError::AlreadyAtTarget;
+        return Result;
+    }
+    const int32 MaxTextureSize = FMath::Max(1, MaxDim >> CookSteps);
     
-    Result.VRAMSavedMB = CalculateFileSizeMB(Result.OriginalWidth, Result.OriginalHeight) - 
-                        CalculateFileSizeMB(Result.FinalWidth, Result.FinalHeight);
-    Result.FileSizeSavedMB = Result.VRAMSavedMB * 0.8f;
+    int64 CookedBytesBefore = CalculateCookedSizeBytes(Texture);
+    
+    // In-game size before the change, scaled from the largest dimension
+    const int32 PreviousWidth = FMath::Max(1, (int32)((int64)Result.OriginalWidth * CurrentMaxDim / MaxDim));
+    const int32 PreviousHeight = FMath::Max(1, (int32)((int64)Result.OriginalHeight * CurrentMaxDim / MaxDim));
     
+    Texture->Modify();
+    Texture->MaxTextureSize = MaxTextureSize;
+    Texture->PostEditChange();
+    Texture->MarkPackageDirty();
+    
+    Result.FinalWidth = FMath::Max(1, Result.OriginalWidth >> LodBias);
+    Result.FinalHeight = FMath::Max(1, Result.OriginalHeight >> LodBias);
+    Result.VRAMSavedMB = CalculateFileSizeMB(PreviousWidth, PreviousHeight) - 
+                        CalculateFileSizeMB(Result.FinalWidth, Result.FinalHeight);
+    // Cooked sizes are modelled from the platform data mips, not read from a cook
+    Result.bEstimated = true;
     Result.bSuccess = true;
     
-    bool bIsNPOT = !IsPowerOfTwo(Result.OriginalWidth) || !IsPowerOfTwo(Result.OriginalHeight);
-    if (bIsNPOT)
+    if (OutPendingCookSizes)
     {
-        UE_LOG(LogBatchTools, Log, TEXT("Proportional reimport calculated for NPOT texture %s: %dx%d -> %dx%d (would save %dMB VRAM)"), 
-               *Texture->GetName(), Result.OriginalWidth, Result.OriginalHeight, Result.FinalWidth, Result.FinalHeight,
-               FMath::RoundToInt(Result.VRAMSavedMB));
+        OutPendingCookSizes->Add({ Texture, INDEX_NONE, CookedBytesBefore });
+        return Result;
     }
-    else
+    
+    FTextureCompilingManager::Get().FinishCompilation({ Texture });
+    ReadCookedSize(Texture, CookedBytesBefore, Result);
+    
+    return Result;
+}
+
+void FBatchToolsModule::ReadCookedSize(UTexture* Texture, int64 CookedBytesBefore, FTextureOptimizationResult& Result)
+{
+    int64 CookedBytesAfter = CalculateCookedSizeBytes(Texture);
+    
+    if (UTexture2D* Texture2D = Cast<UTexture2D>(Texture))
     {
-        UE_LOG(LogBatchTools, Log, TEXT("Proportional reimport calculated for %s: %dx%d -> %dx%d (would save %dMB VRAM)"), 
-               *Texture->GetName(), Result.OriginalWidth, Result.OriginalHeight, Result.FinalWidth, Result.FinalHeight,
-               FMath::RoundToInt(Result.VRAMSavedMB));
+        if (Texture2D->GetPlatformData() && Texture2D->GetPlatformData()->Mips.Num() > 0)
+        {
+            // Cooked mip 0, less the mips the kept LOD bias drops at runtime
+            const int32 Bias = FMath::Max(0, Texture->LODBias);
+            const int32 BuiltWidth = FMath::Max(1, Texture2D->GetPlatformData()->Mips[0].SizeX >> Bias);
+            const int32 BuiltHeight = FMath::Max(1, Texture2D->GetPlatformData()->Mips[0].SizeY >> Bias);
+            Result.VRAMSavedMB += CalculateFileSizeMB(Result.FinalWidth, Result.FinalHeight) - CalculateFileSizeMB(BuiltWidth, BuiltHeight);
+            Result.FinalWidth = BuiltWidth;
+            Result.FinalHeight = BuiltHeight;
+        }
     }
     
-    Result.ErrorMessage = TEXT("Reimport simulation - not executed in demo");
+    Result.FileSizeSavedMB = (float)(CookedBytesBefore - CookedBytesAfter) / (1024.0f * 1024.0f);
     
-    return Result;
+    UE_LOG(LogBatchTools, Log, TEXT("Max in-game size %d applied to %s: %dx%d -> %dx%d (estimated cooked %.2fMB -> %.2fMB)"), 
+           Texture->MaxTextureSize, *Texture->GetName(), Result.OriginalWidth, Result.OriginalHeight, Result.FinalWidth, Result.FinalHeight,
+           CookedBytesBefore / (1024.0f * 1024.0f), CookedBytesAfter / (1024.0f * 1024.0f));
+}
+
+void FBatchToolsModule::FinishPendingCookSizes(const TArray<FPendingCookSize>& PendingCookSizes, FTextureOptimizationResultTable& Results)
+{
+    if (PendingCookSizes.Num() == 0)
+        return;
+    
+    // One wait for the whole batch lets the texture compiler build them in parallel
+    TArray<UTexture*> Textures;
+    Textures.Reserve(PendingCookSizes.Num());
+    for (const FPendingCookSize& Pending : PendingCookSizes)
+    {
+        Textures.Add(Pending.Texture);
+    }
+    FTextureCompilingManager::Get().FinishCompilation(Textures);
+    
+    for (const FPendingCookSize& Pending : PendingCookSizes)
+    {
+        if (Pending.ResultIndex >= 0 && Pending.ResultIndex < Results.Num())
+        {
+            FTextureOptimizationResult Result = Results.GetRow(Pending.ResultIndex);
+            ReadCookedSize(Pending.Texture, Pending.CookedBytesBefore, Result);
+            Results.Set(Pending.ResultIndex, Result);
+        }
+    }
 }
 
 bool FBatchToolsModule::DoesSourceFileExist(UTexture* Texture)
@@ -486,12 +1549,17 @@ EOptimizationMethod FBatchToolsModule::ChooseOptimizationMethod(EOptimizationMet
     }
 }
 
-TArray<FAssetData> FBatchToolsModule::GetTexturesFromPaths(TArray<FString> Paths)
+TArray<FAssetData> FBatchToolsModule::GetTexturesFromPaths(const TArray<FString>& Paths)
+{
+    return GetAssetsFromPaths(Paths, { UTexture::StaticClass()->GetClassPathName(), UTexture2D::StaticClass()->GetClassPathName() });
+}
+
+TArray<FAssetData> FBatchToolsModule::GetAssetsFromPaths(const TArray<FString>& Paths, const TArray<FTopLevelAssetPath>& ClassPaths)
 {
     FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
     IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
     
-    TArray<FAssetData> TextureAssets;
+    TArray<FAssetData> Assets;
     
     for (const FString& Path : Paths)
     {
@@ -500,15 +1568,14 @@ TArray<FAssetData> FBatchToolsModule::GetTexturesFromPaths(TArray<FString> Paths
         
         for (const FAssetData& Asset : AssetsInPath)
         {
-            if (Asset.AssetClassPath == UTexture::StaticClass()->GetClassPathName() || 
-                Asset.AssetClassPath == UTexture2D::StaticClass()->GetClassPathName())
+            if (ClassPaths.Contains(Asset.AssetClassPath))
             {
-                TextureAssets.Add(Asset);
+                Assets.Add(Asset);
             }
         }
     }
     
-    return TextureAssets;
+    return Assets;
 }
 
 int32 FBatchToolsModule::CalculateLODBias(int32 CurrentSize, int32 TargetSize)
@@ -530,6 +1597,17 @@ float FBatchToolsModule::CalculateFileSizeMB(int32 Width, int32 Height)
     return (Width * Height * 4 * 0.25f) / (1024.0f * 1024.0f);
 }
 
+int64 FBatchToolsModule::CalculateCookedSizeBytes(UTexture* Texture)
+{
+    // Estimated from the editor platform data mip chain; the cooker may strip or compress differently
+    FStreamingSimulationTexture MipChain = FBatchToolsStreamingSimulator::GatherTexture(Texture);
+    
+    int64 TotalBytes = 0;
+    for (int64 MipSize : MipChain.MipSizes)
+        TotalBytes += MipSize;
+    return TotalBytes;
+}
+
 bool FBatchToolsModule::IsPowerOfTwo(int32 Value)
 {
     return Value > 0 && (Value & (Value - 1)) == 0;
@@ -719,101 +1797,14 @@ FReply SResolutionDialog::OnCancelClicked()
     return FReply::Handled();
 }
 
-void FBatchToolsModule::ShowOptimizationResults(TArray<FTextureOptimizationResult> Results)
+namespace BatchToolsResults
 {
-    if (Results.Num() == 0)
-        return;
-    
-    int32 TotalProcessed = Results.Num();
-    int32 TotalSuccessful = 0;
-    int32 TotalLODBias = 0;
-    int32 TotalReimport = 0;
-    int32 TotalWithSource = 0;
-    float TotalVRAMSaved = 0.0f;
-    float TotalFileSaved = 0.0f;
-    
-    for (const FTextureOptimizationResult& Result : Results)
-    {
-        if (Result.bSuccess)
-            TotalSuccessful++;
-        if (Result.MethodUsed == EOptimizationMethod::LODBiasOnly)
-            TotalLODBias++;
-        if (Result.MethodUsed == EOptimizationMethod::ReimportOnly)
-            TotalReimport++;
-        if (Result.bHadSourceFile)
-            TotalWithSource++;
-        
-        TotalVRAMSaved += Result.VRAMSavedMB;
-        TotalFileSaved += Result.FileSizeSavedMB;
-    }
-    
-    TSharedPtr<SWindow> ResultsWindow = SNew(SWindow)
-        .Title(LOCTEXT("OptimizationResultsTitle", "Universal Texture Optimization Results"))
-        .ClientSize(FVector2D(600, 500))
-        .SupportsMaximize(true)
-        .SupportsMinimize(false);
-    
-    TSharedPtr<SVerticalBox> ResultsList;
-    
-    ResultsWindow->SetContent(
-        SNew(SBox)
-        .Padding(10)
-        [
-            SNew(SVerticalBox)
-            + SVerticalBox::Slot()
-            .AutoHeight()
-            .Padding(0, 0, 0, 10)
-            [
-                SNew(STextBlock)
-                .Text(FText::Format(
-                    LOCTEXT("ResultsSummary", "Universal Optimization Complete: {0}/{1} textures optimized\nMethods Used: {2} Universal LOD, {3} Proportional Reimport\nTextures with Source Files: {4}/{5}\nVRAM Saved: {6} MB | File Size Saved: {7} MB"),
-                    FText::AsNumber(TotalSuccessful),
-                    FText::AsNumber(TotalProcessed),
-                    FText::AsNumber(TotalLODBias),
-                    FText::AsNumber(TotalReimport),
-                    FText::AsNumber(TotalWithSource),
-                    FText::AsNumber(TotalProcessed),
-                    FText::AsNumber(FMath::RoundToInt(TotalVRAMSaved)),
-                    FText::AsNumber(FMath::RoundToInt(TotalFileSaved))
-                ))
-                .Font(FCoreStyle::GetDefaultFontStyle("Bold", 11))
-            ]
-            + SVerticalBox::Slot()
-            .FillHeight(1.0f)
-            [
-                SNew(SScrollBox)
-                + SScrollBox::Slot()
-                [
-                    SAssignNew(ResultsList, SVerticalBox)
-                ]
-            ]
-            + SVerticalBox::Slot()
-            .AutoHeight()
-            .Padding(0, 10, 0, 0)
-            [
-                SNew(SHorizontalBox)
-                + SHorizontalBox::Slot()
-                .FillWidth(1.0f)
-                + SHorizontalBox::Slot()
-                .AutoWidth()
-                [
-                    SNew(SButton)
-                    .Text(LOCTEXT("CloseButton", "Close"))
-                    .OnClicked_Lambda([ResultsWindow]() {
-                        ResultsWindow->RequestDestroyWindow();
-                        return FReply::Handled();
-                    })
-                ]
-            ]
-        ]
-    );
-    
-    for (const FTextureOptimizationResult& Result : Results)
+    static TSharedRef<ITableRow> MakeResultRow(const FTextureOptimizationResultTable& Table, int32 Row, const TSharedRef<STableViewBase>& OwnerTable)
     {
         FString MethodText;
         FSlateColor StatusColor = FSlateColor::UseForeground();
         
-        switch (Result.MethodUsed)
+        switch (Table.GetMethod(Row))
         {
             case EOptimizationMethod::LODBiasOnly:
                 MethodText = TEXT("🧪 Universal LOD");
@@ -827,17 +1818,87 @@ void FBatchToolsModule::ShowOptimizationResults(TArray<FTextureOptimizationResul
                 MethodText = TEXT("🚀 Hybrid");
                 StatusColor = FSlateColor(FLinearColor::Blue);
                 break;
+            case EOptimizationMethod::MaxInGameSize:
+                MethodText = TEXT("📦 Cook Size");
+                StatusColor = FSlateColor(FLinearColor(0.2f, 0.8f, 1.0f));
+                break;
+            case EOptimizationMethod::MeshLODs:
+                MethodText = TEXT("🔺 Mesh LODs");
+                StatusColor = FSlateColor(FLinearColor(1.0f, 0.5f, 0.0f));
+                break;
+            case EOptimizationMethod::NaniteFallback:
+                MethodText = TEXT("🔺 Nanite Fallback");
+                StatusColor = FSlateColor(FLinearColor(1.0f, 0.5f, 0.0f));
+                break;
+            case EOptimizationMethod::AudioCompression:
+                MethodText = TEXT("🔊 Audio");
+                StatusColor = FSlateColor(FLinearColor(0.7f, 0.4f, 1.0f));
+                break;
+            default:
+                break;
         }
         
-        FString StatusIcon = Result.bSuccess ? TEXT("✅") : TEXT("❌");
-        FString SizeInfo = FString::Printf(TEXT("%dx%d → %dx%d"), 
-            Result.OriginalWidth, Result.OriginalHeight, Result.FinalWidth, Result.FinalHeight);
-        FString SavingsInfo = FString::Printf(TEXT("VRAM: %dMB, File: %dMB"), 
-            FMath::RoundToInt(Result.VRAMSavedMB), FMath::RoundToInt(Result.FileSizeSavedMB));
+        const bool bSuccess = Table.IsSuccess(Row);
+        FString StatusIcon = bSuccess ? TEXT("✅") : TEXT("❌");
+        FString SizeInfo;
+        FString SavingsInfo;
+        FSlateColor NameColor = FSlateColor::UseForeground();
+        FText NameText = FText::FromName(Table.GetTextureName(Row));
+        if (Table.GetAssetKind(Row) == EBatchAssetKind::Folder)
+        {
+            // Folders that started over budget stay highlighted, fixed or not
+            MethodText = TEXT("💰 Folder Budget");
+            StatusColor = FSlateColor(FLinearColor(1.0f, 0.8f, 0.0f));
+            if (Table.IsOverBudget(Row))
+            {
+                NameColor = FSlateColor(FLinearColor(1.0f, 0.5f, 0.0f));
+                NameText = FText::Format(LOCTEXT("OverBudgetFolderName", "⚠ {0}"), NameText);
+            }
+            else
+            {
+                StatusIcon = TEXT("📁");
+            }
+            SizeInfo = FString::Printf(TEXT("%dMB → %dMB"), 
+                FMath::RoundToInt(Table.GetOriginalBytes(Row) / (1024.0 * 1024.0)), FMath::RoundToInt(Table.GetFinalBytes(Row) / (1024.0 * 1024.0)));
+            SavingsInfo = Table.GetError(Row) == EOptimizationError::StillOverBudget
+                ? Table.GetErrorMessage(Row)
+                : FString::Printf(TEXT("Target: %dMB"), FMath::RoundToInt(Table.GetBudgetBytes(Row) / (1024.0 * 1024.0)));
+        }
+        else if (Table.GetAssetKind(Row) == EBatchAssetKind::StaticMesh)
+        {
+            SizeInfo = FString::Printf(TEXT("%u → %u verts, %u → %u indices"), 
+                Table.GetOriginalVertices(Row), Table.GetFinalVertices(Row), Table.GetOriginalIndices(Row), Table.GetFinalIndices(Row));
+            SavingsInfo = bSuccess
+                ? FString::Printf(TEXT("Memory: %.1fMB → %.1fMB"), Table.GetOriginalBytes(Row) / (1024.0 * 1024.0), Table.GetFinalBytes(Row) / (1024.0 * 1024.0))
+                : Table.GetErrorMessage(Row);
+            if (Table.IsOverBudget(Row))
+            {
+                NameColor = FSlateColor(FLinearColor(1.0f, 0.5f, 0.0f));
+                if (bSuccess)
+                    SavingsInfo += TEXT(" | Folder still over budget");
+            }
+        }
+        else if (Table.GetAssetKind(Row) == EBatchAssetKind::SoundWave)
+        {
+            SizeInfo = FString::Printf(TEXT("%u → %u Hz, quality %u → %u"), 
+                Table.GetOriginalSampleRate(Row), Table.GetFinalSampleRate(Row), Table.GetOriginalQuality(Row), Table.GetFinalQuality(Row));
+            SavingsInfo = bSuccess
+                ? FString::Printf(TEXT("Memory: %dMB%s, Disk: %dMB%s"), FMath::RoundToInt(Table.GetMemorySavedMB(Row)), Table.IsEstimated(Row) ? TEXT(" (est.)") : TEXT(""),
+                                  FMath::RoundToInt(Table.GetFileSizeSavedMB(Row)), Table.IsEstimated(Row) ? TEXT(" (est.)") : TEXT(""))
+                : Table.GetErrorMessage(Row);
+        }
+        else
+        {
+            SizeInfo = FString::Printf(TEXT("%dx%d → %dx%d"), 
+                Table.GetOriginalWidth(Row), Table.GetOriginalHeight(Row), Table.GetFinalWidth(Row), Table.GetFinalHeight(Row));
+            SavingsInfo = bSuccess
+                ? FString::Printf(TEXT("VRAM: %dMB, File: %dMB%s"), FMath::RoundToInt(Table.GetVRAMSavedMB(Row)), FMath::RoundToInt(Table.GetFileSizeSavedMB(Row)), 
+                                  Table.IsEstimated(Row) ? TEXT(" (est.)") : TEXT(""))
+                : Table.GetErrorMessage(Row);
+        }
         
-        ResultsList->AddSlot()
-        .AutoHeight()
-        .Padding(0, 2)
+        return SNew(STableRow<TSharedPtr<int32>>, OwnerTable)
+        .Padding(FMargin(0, 2))
         [
             SNew(SHorizontalBox)
             + SHorizontalBox::Slot()
@@ -852,7 +1913,8 @@ void FBatchToolsModule::ShowOptimizationResults(TArray<FTextureOptimizationResul
             .FillWidth(0.3f)
             [
                 SNew(STextBlock)
-                .Text(FText::FromString(Result.TextureName))
+                .Text(NameText)
+                .ColorAndOpacity(NameColor)
                 .Font(FCoreStyle::GetDefaultFontStyle("Bold", 9))
             ]
             + SHorizontalBox::Slot()
@@ -874,19 +1936,179 @@ void FBatchToolsModule::ShowOptimizationResults(TArray<FTextureOptimizationResul
             .FillWidth(0.3f)
             [
                 SNew(STextBlock)
-                .Text(Result.bSuccess ? FText::FromString(SavingsInfo) : FText::FromString(Result.ErrorMessage))
+                .Text(FText::FromString(SavingsInfo))
                 .Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
-                .ColorAndOpacity(Result.bSuccess ? FSlateColor::UseForeground() : FSlateColor(FLinearColor::Red))
+                .ColorAndOpacity(bSuccess || Table.GetError(Row) == EOptimizationError::WithinBudget || Table.GetError(Row) == EOptimizationError::NoBudget ? FSlateColor::UseForeground() : FSlateColor(FLinearColor::Red))
             ]
         ];
     }
+}
+
+void FBatchToolsModule::ShowOptimizationResults(FTextureOptimizationResultTable&& Results, const FStreamingSimulationReport& StreamingReport)
+{
+    if (Results.IsEmpty())
+        return;
+    
+    const FTextureOptimizationTotals Totals = Results.ComputeTotals();
+    // Mesh, sound and folder rows have their own summary lines
+    const int32 TotalProcessed = Totals.GetKindCount(EBatchAssetKind::Texture);
+    const int32 TotalSuccessful = Totals.GetKindSuccessCount(EBatchAssetKind::Texture);
+    const int32 TotalLODBias = Totals.GetMethodCount(EOptimizationMethod::LODBiasOnly);
+    const int32 TotalReimport = Totals.GetMethodCount(EOptimizationMethod::ReimportOnly);
+    const int32 TotalMaxSize = Totals.GetMethodCount(EOptimizationMethod::MaxInGameSize);
+    const int32 TotalWithSource = Totals.NumWithSource;
+    const float TotalVRAMSaved = (float)Totals.VRAMSavedMB;
+    const float TotalFileSaved = (float)Totals.FileSizeSavedMB;
+    const int32 TotalMeshes = Totals.GetKindCount(EBatchAssetKind::StaticMesh);
+    const int32 TotalMeshLODs = Totals.GetMethodCount(EOptimizationMethod::MeshLODs);
+    const int32 TotalNaniteFallback = Totals.GetMethodCount(EOptimizationMethod::NaniteFallback);
+    const int32 TotalSounds = Totals.GetKindCount(EBatchAssetKind::SoundWave);
+    const int32 TotalFolders = Totals.GetKindCount(EBatchAssetKind::Folder);
+    const int32 TotalStillOverBudget = Totals.GetErrorCount(EOptimizationError::StillOverBudget);
+    
+    // The window owns the table; list items alias one shared index array instead of allocating per row
+    TSharedRef<const FTextureOptimizationResultTable> Table = MakeShared<FTextureOptimizationResultTable>(MoveTemp(Results));
+    TSharedRef<TArray<int32>> RowIndices = MakeShared<TArray<int32>>();
+    RowIndices->SetNumUninitialized(Table->Num());
+    for (int32 Row = 0; Row < Table->Num(); Row++)
+        (*RowIndices)[Row] = Row;
+    
+    TSharedRef<TArray<TSharedPtr<int32>>> ListItems = MakeShared<TArray<TSharedPtr<int32>>>();
+    ListItems->Reserve(Table->Num());
+    for (int32& Row : *RowIndices)
+        ListItems->Add(TSharedPtr<int32>(RowIndices, &Row));
+    
+    TSharedPtr<SWindow> ResultsWindow = SNew(SWindow)
+        .Title(LOCTEXT("OptimizationResultsTitle", "Universal Texture Optimization Results"))
+        .ClientSize(FVector2D(600, 500))
+        .SupportsMaximize(true)
+        .SupportsMinimize(false);
+    
+    ResultsWindow->SetContent(
+        SNew(SBox)
+        .Padding(10)
+        [
+            SNew(SVerticalBox)
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0, 0, 0, 10)
+            [
+                SNew(STextBlock)
+                .Text(FText::Format(
+                    LOCTEXT("ResultsSummary", "Universal Optimization Complete: {0}/{1} textures optimized\nMethods Used: {2} Universal LOD, {3} Proportional Reimport, {8} Cook Size Limit\nTextures with Source Files: {4}/{5}\nVRAM Saved: {6} MB | File Size Saved: {7} MB"),
+                    FText::AsNumber(TotalSuccessful),
+                    FText::AsNumber(TotalProcessed),
+                    FText::AsNumber(TotalLODBias),
+                    FText::AsNumber(TotalReimport),
+                    FText::AsNumber(TotalWithSource),
+                    FText::AsNumber(TotalProcessed),
+                    FText::AsNumber(FMath::RoundToInt(TotalVRAMSaved)),
+                    FText::AsNumber(FMath::RoundToInt(TotalFileSaved)),
+                    FText::AsNumber(TotalMaxSize)
+                ))
+                .Font(FCoreStyle::GetDefaultFontStyle("Bold", 11))
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0, 0, 0, 10)
+            [
+                SNew(STextBlock)
+                .Visibility(TotalMeshes > 0 ? EVisibility::Visible : EVisibility::Collapsed)
+                .Text(FText::Format(
+                    LOCTEXT("MeshSummary", "Static Meshes: {0} processed | Methods Used: {1} Mesh LODs, {2} Nanite Fallback"),
+                    FText::AsNumber(TotalMeshes),
+                    FText::AsNumber(TotalMeshLODs),
+                    FText::AsNumber(TotalNaniteFallback)
+                ))
+                .Font(FCoreStyle::GetDefaultFontStyle("Regular", 10))
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0, 0, 0, 10)
+            [
+                SNew(STextBlock)
+                .Visibility(TotalFolders > 0 ? EVisibility::Visible : EVisibility::Collapsed)
+                .Text(FText::Format(
+                    LOCTEXT("FolderBudgetSummary", "Folder Budgets: {0} folders, {1} over budget, {2} still over after enforcement"),
+                    FText::AsNumber(TotalFolders),
+                    FText::AsNumber(Totals.NumOverBudget),
+                    FText::AsNumber(TotalStillOverBudget)
+                ))
+                .ColorAndOpacity(Totals.NumOverBudget > 0 ? FSlateColor(FLinearColor(1.0f, 0.5f, 0.0f)) : FSlateColor::UseForeground())
+                .Font(FCoreStyle::GetDefaultFontStyle("Regular", 10))
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0, 0, 0, 10)
+            [
+                SNew(STextBlock)
+                .Visibility(TotalSounds > 0 ? EVisibility::Visible : EVisibility::Collapsed)
+                .Text(FText::Format(
+                    LOCTEXT("AudioSummary", "Sound Waves: {0} processed | Audio Memory Saved: {1} MB | Sizes are estimated until the next cook"),
+                    FText::AsNumber(TotalSounds),
+                    FText::AsNumber(FMath::RoundToInt(Totals.AudioMemorySavedMB))
+                ))
+                .Font(FCoreStyle::GetDefaultFontStyle("Regular", 10))
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0, 0, 0, 10)
+            [
+                SNew(STextBlock)
+                .Visibility(StreamingReport.NumTextures > 0 ? EVisibility::Visible : EVisibility::Collapsed)
+                .Text(FText::Format(
+                    LOCTEXT("StreamingSummary", "Streaming Pool (simulated): {0} MB → {1} MB of {2} MB | Overcommit: {3} MB → {4} MB\nVirtual Texture Pool (simulated): {5} MB → {6} MB of {7} MB | Overcommit: {8} MB → {9} MB"),
+                    FText::AsNumber(FMath::RoundToInt(StreamingReport.BeforeResidentMB)),
+                    FText::AsNumber(FMath::RoundToInt(StreamingReport.AfterResidentMB)),
+                    FText::AsNumber(FMath::RoundToInt(StreamingReport.PoolSizeMB)),
+                    FText::AsNumber(FMath::RoundToInt(StreamingReport.GetBeforeOvercommitMB())),
+                    FText::AsNumber(FMath::RoundToInt(StreamingReport.GetAfterOvercommitMB())),
+                    FText::AsNumber(FMath::RoundToInt(StreamingReport.BeforeVirtualTextureResidentMB)),
+                    FText::AsNumber(FMath::RoundToInt(StreamingReport.AfterVirtualTextureResidentMB)),
+                    FText::AsNumber(FMath::RoundToInt(StreamingReport.VirtualTexturePoolSizeMB)),
+                    FText::AsNumber(FMath::RoundToInt(StreamingReport.GetBeforeVirtualTextureOvercommitMB())),
+                    FText::AsNumber(FMath::RoundToInt(StreamingReport.GetAfterVirtualTextureOvercommitMB()))
+                ))
+                .Font(FCoreStyle::GetDefaultFontStyle("Regular", 10))
+            ]
+            + SVerticalBox::Slot()
+            .FillHeight(1.0f)
+            [
+                SNew(SListView<TSharedPtr<int32>>)
+                .ListItemsSource(&ListItems.Get())
+                .SelectionMode(ESelectionMode::None)
+                .OnGenerateRow_Lambda([Table, ListItems](TSharedPtr<int32> Item, const TSharedRef<STableViewBase>& OwnerTable)
+                {
+                    return BatchToolsResults::MakeResultRow(*Table, *Item, OwnerTable);
+                })
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0, 10, 0, 0)
+            [
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SButton)
+                    .Text(LOCTEXT("CloseButton", "Close"))
+                    .OnClicked_Lambda([ResultsWindow]() {
+                        ResultsWindow->RequestDestroyWindow();
+                        return FReply::Handled();
+                    })
+                ]
+            ]
+        ]
+    );
     
     FSlateApplication::Get().AddWindow(ResultsWindow.ToSharedRef());
     
     FText NotificationText = FText::Format(
-        LOCTEXT("OptimizationNotification", "Universal Texture Optimization Complete: {0}/{1} optimized, {2}MB VRAM saved"),
-        FText::AsNumber(TotalSuccessful),
-        FText::AsNumber(TotalProcessed),
+        LOCTEXT("OptimizationNotification", "Universal Optimization Complete: {0}/{1} assets optimized, {2}MB VRAM saved"),
+        FText::AsNumber(Totals.NumSuccessful),
+        FText::AsNumber(Totals.NumRows),
         FText::AsNumber(FMath::RoundToInt(TotalVRAMSaved))
     );
     
@@ -896,6 +2118,11 @@ void FBatchToolsModule::ShowOptimizationResults(TArray<FTextureOptimizationResul
     
     UE_LOG(LogBatchTools, Log, TEXT("Universal optimization completed: %d/%d textures optimized, %dMB VRAM saved, %dMB file size saved"), 
            TotalSuccessful, TotalProcessed, FMath::RoundToInt(TotalVRAMSaved), FMath::RoundToInt(TotalFileSaved));
+    
+    UE_LOG(LogBatchTools, Log, TEXT("Simulated streaming pool residency: %.1fMB -> %.1fMB of %.0fMB (overcommit %.1fMB -> %.1fMB), VT pool: %.1fMB -> %.1fMB of %.0fMB"), 
+           StreamingReport.BeforeResidentMB, StreamingReport.AfterResidentMB, StreamingReport.PoolSizeMB,
+           StreamingReport.GetBeforeOvercommitMB(), StreamingReport.GetAfterOvercommitMB(),
+           StreamingReport.BeforeVirtualTextureResidentMB, StreamingReport.AfterVirtualTextureResidentMB, StreamingReport.VirtualTexturePoolSizeMB);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include "BatchToolsPolicy.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Parse.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+
+namespace BatchToolsPolicy
+{
+    static const TCHAR* ConfigSection = TEXT("BatchTools.Policy");
+    static const TCHAR* TextureGroupPrefix = TEXT("TEXTUREGROUP_");
+    static const FName LODGroupTag(TEXT("LODGroup"));
+
+    static TUniquePtr<FBatchToolsPolicy> Instance;
+
+    static FAutoConsoleCommand ReloadPolicyCommand(
+        TEXT("BatchTools.ReloadPolicy"),
+        TEXT("Rereads the [BatchTools.Policy] rules from DefaultBatchTools.ini"),
+        FConsoleCommandDelegate::CreateStatic(&FBatchToolsPolicy::Reload));
+
+    static void SplitPath(FStringView Path, TArray<FStringView>& OutSegments)
+    {
+        int32 SegmentStart = 0;
+        for (int32 Index = 0; Index <= Path.Len(); Index++)
+        {
+            if (Index == Path.Len() || Path[Index] == TEXT('/'))
+            {
+                if (Index > SegmentStart)
+                    OutSegments.Add(Path.Mid(SegmentStart, Index - SegmentStart));
+                SegmentStart = Index + 1;
+            }
+        }
+    }
+
+    static bool HasWildcard(FStringView Segment)
+    {
+        int32 Unused;
+        return Segment.FindChar(TEXT('*'), Unused) || Segment.FindChar(TEXT('?'), Unused);
+    }
+}
+
+bool FTexturePolicyRule::Parse(const FString& RuleText, FTexturePolicyRule& OutRule)
+{
+    OutRule = FTexturePolicyRule();
+    const TCHAR* Stream = *RuleText;
+    FString Value;
+
+    FParse::Value(Stream, TEXT("Path="), OutRule.PathPattern);
+    FParse::Value(Stream, TEXT("Name="), OutRule.NamePattern);
+
+    if (FParse::Value(Stream, TEXT("LODGroup="), Value))
+    {
+        if (!Value.StartsWith(BatchToolsPolicy::TextureGroupPrefix))
+            Value = BatchToolsPolicy::TextureGroupPrefix + Value;
+        OutRule.LODGroup = FName(*Value);
+    }
+
+    if (FParse::Value(Stream, TEXT("Action="), Value))
+    {
+        if (Value.Equals(TEXT("Skip")) || Value.Equals(TEXT("Never")))
+            OutRule.bSkip = true;
+        else if (Value.Equals(TEXT("Optimize")))
+            OutRule.bSkip = false;
+        else
+            UE_LOG(LogBatchTools, Warning, TEXT("Unknown policy action '%s' in rule %s"), *Value, *RuleText);
+    }
+
+    if (FParse::Value(Stream, TEXT("TextureType="), Value))
+    {
+        OutRule.bNormalMap = Value.Equals(TEXT("NormalMap")) || Value.Equals(TEXT("Normal"));
+    }
+
+    int32 MaxSize = 0;
+    if (FParse::Value(Stream, TEXT("MaxSize="), MaxSize))
+        OutRule.MaxSize = FMath::Max(0, MaxSize);
+
+    float BudgetWeight = 1.0f;
+    if (FParse::Value(Stream, TEXT("BudgetWeight="), BudgetWeight))
+        OutRule.BudgetWeight = FMath::Max(0.0f, BudgetWeight);
+
+    if (FParse::Value(Stream, TEXT("Method="), Value))
+    {
+        EOptimizationMethod Method;
+        if (LexTryParseString(Method, *Value))
+            OutRule.Method = Method;
+        else
+            UE_LOG(LogBatchTools, Warning, TEXT("Unknown optimization method '%s' in rule %s"), *Value, *RuleText);
+    }
+
+    const bool bHasAction = OutRule.bSkip.IsSet() || OutRule.bNormalMap.IsSet() || OutRule.MaxSize.IsSet() ||
+                            OutRule.BudgetWeight.IsSet() || OutRule.Method.IsSet();
+    return bHasAction;
+}
+
+const FBatchToolsPolicy& FBatchToolsPolicy::Get()
+{
+    // Loaded in StartupModule, so worker threads never race to create it
+    checkf(BatchToolsPolicy::Instance.IsValid(), TEXT("FBatchToolsPolicy::Get called before the BatchTools module started"));
+    return *BatchToolsPolicy::Instance;
+}
+
+void FBatchToolsPolicy::Reload()
+{
+    // Batches read the policy from worker threads, and those only run while the game thread waits on them
+    check(IsInGameThread());
+
+    FString ConfigFilename;
+    FConfigCacheIni::LoadGlobalIniFile(ConfigFilename, TEXT("BatchTools"), nullptr, /*bForceReload*/ true);
+
+    TArray<FString> RuleStrings;
+    GConfig->GetArray(BatchToolsPolicy::ConfigSection, TEXT("Rules"), RuleStrings, FBatchToolsModule::GetConfigFilename());
+
+    TArray<FTexturePolicyRule> ParsedRules;
+    for (const FString& RuleString : RuleStrings)
+    {
+        FTexturePolicyRule Rule;
+        if (FTexturePolicyRule::Parse(RuleString, Rule))
+            ParsedRules.Add(MoveTemp(Rule));
+        else
+            UE_LOG(LogBatchTools, Warning, TEXT("Ignoring policy rule without an action: %s"), *RuleString);
+    }
+
+    BatchToolsPolicy::Instance = MakeUnique<FBatchToolsPolicy>();
+    BatchToolsPolicy::Instance->Compile(ParsedRules);
+
+    UE_LOG(LogBatchTools, Log, TEXT("Loaded %d optimization policy rules"), ParsedRules.Num());
+}
+
+void FBatchToolsPolicy::FGlob::Compile(const FString& InPattern)
+{
+    Pattern = InPattern;
+    bMatchAll = Pattern.IsEmpty() || Pattern == TEXT("*") || Pattern == TEXT("**");
+}
+
+bool FBatchToolsPolicy::FGlob::Matches(const TCHAR* Text, int32 TextLen) const
+{
+    if (bMatchAll)
+        return true;
+
+    const TCHAR* Wild = *Pattern;
+    const int32 WildLen = Pattern.Len();
+    int32 TextIndex = 0;
+    int32 WildIndex = 0;
+    int32 StarIndex = INDEX_NONE;
+    int32 StarTextIndex = 0;
+
+    // Greedy wildcard match, backtracking to the last '*'
+    while (TextIndex < TextLen)
+    {
+        if (WildIndex < WildLen && (Wild[WildIndex] == TEXT('?') || FChar::ToLower(Wild[WildIndex]) == FChar::ToLower(Text[TextIndex])))
+        {
+            WildIndex++;
+            TextIndex++;
+        }
+        else if (WildIndex < WildLen && Wild[WildIndex] == TEXT('*'))
+        {
+            StarIndex = WildIndex++;
+            StarTextIndex = TextIndex;
+        }
+        else if (StarIndex != INDEX_NONE)
+        {
+            WildIndex = StarIndex + 1;
+            TextIndex = ++StarTextIndex;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    while (WildIndex < WildLen && Wild[WildIndex] == TEXT('*'))
+        WildIndex++;
+
+    return WildIndex == WildLen;
+}
+
+void FBatchToolsPolicy::Compile(const TArray<FTexturePolicyRule>& InRules)
+{
+    Rules.Reset(InRules.Num());
+    Trie.Reset();
+    Trie.AddDefaulted();
+
+    for (const FTexturePolicyRule& Rule : InRules)
+    {
+        const int32 RuleIndex = Rules.AddDefaulted();
+        FCompiledRule& CompiledRule = Rules[RuleIndex];
+        CompiledRule.Rule = Rule;
+        CompiledRule.NameGlob.Compile(Rule.NamePattern);
+
+        TArray<FStringView> Segments;
+        BatchToolsPolicy::SplitPath(Rule.PathPattern, Segments);
+
+        // A plain folder means everything below it
+        if (Segments.Num() > 0 && !BatchToolsPolicy::HasWildcard(Segments.Last()))
+            Segments.Add(TEXT("**"));
+        if (Segments.Num() == 0)
+            Segments.Add(TEXT("**"));
+
+        // The literal prefix goes into the trie, the rest is matched per candidate
+        int32 NodeIndex = 0;
+        int32 SegmentIndex = 0;
+        for (; SegmentIndex < Segments.Num() && !BatchToolsPolicy::HasWildcard(Segments[SegmentIndex]); SegmentIndex++)
+        {
+            const FName SegmentName(Segments[SegmentIndex].Len(), Segments[SegmentIndex].GetData());
+            if (const int32* ChildIndex = Trie[NodeIndex].Children.Find(SegmentName))
+            {
+                NodeIndex = *ChildIndex;
+            }
+            else
+            {
+                const int32 NewIndex = Trie.AddDefaulted();
+                Trie[NodeIndex].Children.Add(SegmentName, NewIndex);
+                NodeIndex = NewIndex;
+            }
+        }
+
+        for (; SegmentIndex < Segments.Num(); SegmentIndex++)
+        {
+            FGlob& Glob = CompiledRule.RemainingSegments.AddDefaulted_GetRef();
+            Glob.Compile(FString(Segments[SegmentIndex]));
+        }
+
+        Trie[NodeIndex].RuleIndices.Add(RuleIndex);
+    }
+}
+
+bool FBatchToolsPolicy::MatchesRemainingSegments(const FCompiledRule& CompiledRule, const TArray<FStringView>& Segments, int32 SegmentIndex, int32 GlobIndex) const
+{
+    if (GlobIndex == CompiledRule.RemainingSegments.Num())
+        return SegmentIndex == Segments.Num();
+
+    const FGlob& Glob = CompiledRule.RemainingSegments[GlobIndex];
+    if (Glob.Pattern == TEXT("**"))
+    {
+        for (int32 NextSegment = SegmentIndex; NextSegment <= Segments.Num(); NextSegment++)
+        {
+            if (MatchesRemainingSegments(CompiledRule, Segments, NextSegment, GlobIndex + 1))
+                return true;
+        }
+        return false;
+    }
+
+    if (SegmentIndex >= Segments.Num())
+        return false;
+
+    return Glob.Matches(Segments[SegmentIndex].GetData(), Segments[SegmentIndex].Len()) &&
+           MatchesRemainingSegments(CompiledRule, Segments, SegmentIndex + 1, GlobIndex + 1);
+}
+
+FTexturePolicyDecision FBatchToolsPolicy::Evaluate(const FAssetData& Asset) const
+{
+    FTexturePolicyDecision Decision;
+    if (Rules.Num() == 0)
+        return Decision;
+
+    TStringBuilder<256> PackageName;
+    Asset.PackageName.ToString(PackageName);
+
+    TArray<FStringView> Segments;
+    BatchToolsPolicy::SplitPath(PackageName.ToView(), Segments);
+
+    // Walk the trie collecting rules whose literal prefix matches, with the depth they matched at
+    TArray<TPair<int32, int32>, TInlineAllocator<16>> Candidates;
+    int32 NodeIndex = 0;
+    for (int32 Depth = 0; ; Depth++)
+    {
+        for (int32 RuleIndex : Trie[NodeIndex].RuleIndices)
+            Candidates.Emplace(RuleIndex, Depth);
+
+        if (Depth >= Segments.Num())
+            break;
+
+        const FName SegmentName(Segments[Depth].Len(), Segments[Depth].GetData(), FNAME_Find);
+        const int32* ChildIndex = SegmentName.IsNone() ? nullptr : Trie[NodeIndex].Children.Find(SegmentName);
+        if (!ChildIndex)
+            break;
+        NodeIndex = *ChildIndex;
+    }
+
+    if (Candidates.Num() == 0)
+        return Decision;
+
+    // Rules apply in declaration order
+    Candidates.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B) { return A.Key < B.Key; });
+
+    TStringBuilder<128> AssetName;
+    Asset.AssetName.ToString(AssetName);
+
+    FName LODGroup;
+    bool bLODGroupResolved = false;
+
+    for (const TPair<int32, int32>& Candidate : Candidates)
+    {
+        const FCompiledRule& CompiledRule = Rules[Candidate.Key];
+        const FTexturePolicyRule& Rule = CompiledRule.Rule;
+
+        if (!CompiledRule.NameGlob.Matches(AssetName.GetData(), AssetName.Len()))
+            continue;
+
+        if (!Rule.LODGroup.IsNone())
+        {
+            if (!bLODGroupResolved)
+            {
+                FString LODGroupValue;
+                if (Asset.GetTagValue(BatchToolsPolicy::LODGroupTag, LODGroupValue))
+                    LODGroup = FName(*LODGroupValue, FNAME_Find);
+                bLODGroupResolved = true;
+            }
+            if (LODGroup != Rule.LODGroup)
+                continue;
+        }
+
+        if (!MatchesRemainingSegments(CompiledRule, Segments, Candidate.Value, 0))
+            continue;
+
+        if (Rule.bSkip.IsSet())
+            Decision.bSkip = Rule.bSkip.GetValue();
+        if (Rule.bNormalMap.IsSet())
+            Decision.bNormalMap = Rule.bNormalMap.GetValue();
+        if (Rule.MaxSize.IsSet())
+            Decision.MaxSize = Rule.MaxSize.GetValue();
+        if (Rule.BudgetWeight.IsSet())
+            Decision.BudgetWeight = Rule.BudgetWeight.GetValue();
+        if (Rule.Method.IsSet())
+            Decision.Method = Rule.Method;
+    }
+
+    return Decision;
+}
+
+TArray<FTexturePolicyDecision> FBatchToolsPolicy::EvaluateBatch(const TArray<FAssetData>& Assets) const
+{
+    TArray<FTexturePolicyDecision> Decisions;
+    Decisions.SetNum(Assets.Num());
+
+    if (Rules.Num() > 0)
+    {
+        ParallelFor(Assets.Num(), [this, &Assets, &Decisions](int32 Index)
+        {
+            Decisions[Index] = Evaluate(Assets[Index]);
+        });
+    }
+
+    return Decisions;
+}
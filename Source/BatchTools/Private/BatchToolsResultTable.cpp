@@ -0,0 +1,441 @@
+#include "BatchToolsResultTable.h"
+#include "Math/VectorRegister.h"
+
+const TCHAR* LexToString(EOptimizationError Error)
+{
+    switch (Error)
+    {
+        case EOptimizationError::None:
+            return TEXT("None");
+        case EOptimizationError::AlreadyAtTarget:
+            return TEXT("AlreadyAtTarget");
+        case EOptimizationError::NoLODBias:
+            return TEXT("NoLODBias");
+        case EOptimizationError::SourceFileMissing:
+            return TEXT("SourceFileMissing");
+        case EOptimizationError::ReimportSimulated:
+            return TEXT("ReimportSimulated");
+        case EOptimizationError::SkippedByPolicy:
+            return TEXT("SkippedByPolicy");
+        case EOptimizationError::LoadFailed:
+            return TEXT("LoadFailed");
+        case EOptimizationError::NotATexture:
+            return TEXT("NotATexture");
+        case EOptimizationError::UnsavedChanges:
+            return TEXT("UnsavedChanges");
+        case EOptimizationError::NoWorkerResult:
+            return TEXT("NoWorkerResult");
+        case EOptimizationError::Cancelled:
+            return TEXT("Cancelled");
+        case EOptimizationError::SourceDecodeFailed:
+            return TEXT("SourceDecodeFailed");
+        case EOptimizationError::TelemetryUnchanged:
+            return TEXT("TelemetryUnchanged");
+        case EOptimizationError::WithinBudget:
+            return TEXT("WithinBudget");
+        case EOptimizationError::AudioUnchanged:
+            return TEXT("AudioUnchanged");
+        case EOptimizationError::StillOverBudget:
+            return TEXT("StillOverBudget");
+        case EOptimizationError::NoBudget:
+            return TEXT("NoBudget");
+        case EOptimizationError::CheckoutFailed:
+            return TEXT("CheckoutFailed");
+        case EOptimizationError::OpenInEditor:
+            return TEXT("OpenInEditor");
+        case EOptimizationError::ReimportTrial:
+            return TEXT("ReimportTrial");
+        case EOptimizationError::SaveFailed:
+            return TEXT("SaveFailed");
+        default:
+            break;
+    }
+    return TEXT("Unknown");
+}
+
+bool LexTryParseString(EOptimizationError& OutError, const TCHAR* Buffer)
+{
+    for (int32 ErrorIndex = 0; ErrorIndex < (int32)EOptimizationError::Count; ErrorIndex++)
+    {
+        if (FCString::Stricmp(Buffer, LexToString((EOptimizationError)ErrorIndex)) == 0)
+        {
+            OutError = (EOptimizationError)ErrorIndex;
+            return true;
+        }
+    }
+    return false;
+}
+
+FString FormatOptimizationError(EOptimizationError Error, int32 Width, int32 Height, int32 TargetResolution)
+{
+    switch (Error)
+    {
+        case EOptimizationError::None:
+            return FString();
+        case EOptimizationError::AlreadyAtTarget:
+            if (TargetResolution > 0)
+                return FString::Printf(TEXT("Already at target size (%dx%d <= %d)"), Width, Height, TargetResolution);
+            return FString::Printf(TEXT("Already at target size (%dx%d)"), Width, Height);
+        case EOptimizationError::NoLODBias:
+            return TEXT("Could not calculate effective LOD Bias");
+        case EOptimizationError::SourceFileMissing:
+            return TEXT("Source file not found - cannot reimport");
+        case EOptimizationError::ReimportSimulated:
+            return TEXT("Reimport calculated only - not supported for this texture type");
+        case EOptimizationError::SkippedByPolicy:
+            return TEXT("Skipped by project policy");
+        case EOptimizationError::LoadFailed:
+            return TEXT("Failed to load texture");
+        case EOptimizationError::NotATexture:
+            return TEXT("Not a texture");
+        case EOptimizationError::UnsavedChanges:
+            return TEXT("Package has unsaved changes - save before a sharded run");
+        case EOptimizationError::NoWorkerResult:
+            return TEXT("Worker process did not report a result");
+        case EOptimizationError::Cancelled:
+            return TEXT("Cancelled");
+        case EOptimizationError::SourceDecodeFailed:
+            return TEXT("Could not decode source file");
+        case EOptimizationError::TelemetryUnchanged:
+            return TEXT("LOD bias already matches streaming telemetry");
+        case EOptimizationError::WithinBudget:
+            return TEXT("Folder is within its budget");
+        case EOptimizationError::AudioUnchanged:
+            return TEXT("Sample rate and quality already fit the budget");
+        case EOptimizationError::StillOverBudget:
+            return TEXT("Still over budget - not enough reducible assets");
+        case EOptimizationError::NoBudget:
+            return TEXT("No budget covers this folder");
+        case EOptimizationError::CheckoutFailed:
+            return TEXT("Could not check out the package - changes were not saved");
+        case EOptimizationError::OpenInEditor:
+            return TEXT("Asset is open in an editor - close it before a sharded run");
+        case EOptimizationError::ReimportTrial:
+            return TEXT("Trial only - source left unchanged, enable bWriteSource to apply");
+        case EOptimizationError::SaveFailed:
+            return TEXT("Could not save the package - changes were discarded");
+        default:
+            break;
+    }
+    return TEXT("Unknown error");
+}
+
+void FTextureOptimizationResultTable::Reserve(int32 NumRows)
+{
+    TextureNames.Reserve(NumRows);
+    PackageNames.Reserve(NumRows);
+    OriginalWidths.Reserve(NumRows);
+    OriginalHeights.Reserve(NumRows);
+    FinalWidths.Reserve(NumRows);
+    FinalHeights.Reserve(NumRows);
+    TargetResolutions.Reserve(NumRows);
+    VRAMSavedMB.Reserve(NumRows);
+    FileSizeSavedMB.Reserve(NumRows);
+    Flags.Reserve(NumRows);
+    Methods.Reserve(NumRows);
+    Errors.Reserve(NumRows);
+    Kinds.Reserve(NumRows);
+}
+
+void FTextureOptimizationResultTable::Reset()
+{
+    TextureNames.Reset();
+    PackageNames.Reset();
+    OriginalWidths.Reset();
+    OriginalHeights.Reset();
+    FinalWidths.Reset();
+    FinalHeights.Reset();
+    TargetResolutions.Reset();
+    VRAMSavedMB.Reset();
+    FileSizeSavedMB.Reset();
+    Flags.Reset();
+    Methods.Reset();
+    Errors.Reset();
+    Kinds.Reset();
+    MeshData.Reset();
+    SoundData.Reset();
+    FolderData.Reset();
+}
+
+uint8 FTextureOptimizationResultTable::MakeFlags(const FTextureOptimizationResult& Result)
+{
+    return (Result.bSuccess ? RowFlag_Success : 0) | (Result.bHadSourceFile ? RowFlag_HadSource : 0) 
+        | (Result.bOverBudget ? RowFlag_OverBudget : 0) | (Result.bEstimated ? RowFlag_Estimated : 0);
+}
+
+int32 FTextureOptimizationResultTable::Add(const FTextureOptimizationResult& Result)
+{
+    const int32 Row = TextureNames.Add(Result.TextureName);
+    PackageNames.Add(Result.PackageName);
+    OriginalWidths.Add(Result.OriginalWidth);
+    OriginalHeights.Add(Result.OriginalHeight);
+    FinalWidths.Add(Result.FinalWidth);
+    FinalHeights.Add(Result.FinalHeight);
+    TargetResolutions.Add(Result.TargetResolution);
+    VRAMSavedMB.Add(Result.VRAMSavedMB);
+    FileSizeSavedMB.Add(Result.FileSizeSavedMB);
+    Flags.Add(MakeFlags(Result));
+    Methods.Add(Result.MethodUsed);
+    Errors.Add(Result.Error);
+    Kinds.Add(Result.AssetKind);
+    SetKindData(Row, Result);
+    return Row;
+}
+
+void FTextureOptimizationResultTable::Append(const FTextureOptimizationResultTable& Other)
+{
+    const int32 RowOffset = Num();
+    TextureNames.Append(Other.TextureNames);
+    PackageNames.Append(Other.PackageNames);
+    OriginalWidths.Append(Other.OriginalWidths);
+    OriginalHeights.Append(Other.OriginalHeights);
+    FinalWidths.Append(Other.FinalWidths);
+    FinalHeights.Append(Other.FinalHeights);
+    TargetResolutions.Append(Other.TargetResolutions);
+    VRAMSavedMB.Append(Other.VRAMSavedMB);
+    FileSizeSavedMB.Append(Other.FileSizeSavedMB);
+    Flags.Append(Other.Flags);
+    Methods.Append(Other.Methods);
+    Errors.Append(Other.Errors);
+    Kinds.Append(Other.Kinds);
+    MeshData.Append(Other.MeshData, RowOffset);
+    SoundData.Append(Other.SoundData, RowOffset);
+    FolderData.Append(Other.FolderData, RowOffset);
+}
+
+void FTextureOptimizationResultTable::Set(int32 Row, const FTextureOptimizationResult& Result)
+{
+    TextureNames[Row] = Result.TextureName;
+    PackageNames[Row] = Result.PackageName;
+    OriginalWidths[Row] = Result.OriginalWidth;
+    OriginalHeights[Row] = Result.OriginalHeight;
+    FinalWidths[Row] = Result.FinalWidth;
+    FinalHeights[Row] = Result.FinalHeight;
+    TargetResolutions[Row] = Result.TargetResolution;
+    VRAMSavedMB[Row] = Result.VRAMSavedMB;
+    FileSizeSavedMB[Row] = Result.FileSizeSavedMB;
+    Flags[Row] = MakeFlags(Result);
+    Methods[Row] = Result.MethodUsed;
+    Errors[Row] = Result.Error;
+    if (Kinds[Row] != Result.AssetKind)
+    {
+        MeshData.Remove(Row);
+        SoundData.Remove(Row);
+        FolderData.Remove(Row);
+        Kinds[Row] = Result.AssetKind;
+    }
+    SetKindData(Row, Result);
+}
+
+void FTextureOptimizationResultTable::SetKindData(int32 Row, const FTextureOptimizationResult& Result)
+{
+    switch (Result.AssetKind)
+    {
+        case EBatchAssetKind::StaticMesh:
+            MeshData.Set(Row, { Result.OriginalVertices, Result.FinalVertices, Result.OriginalIndices, Result.FinalIndices, Result.OriginalBytes, Result.FinalBytes });
+            break;
+        case EBatchAssetKind::SoundWave:
+            SoundData.Set(Row, { Result.OriginalSampleRate, Result.FinalSampleRate, Result.OriginalQuality, Result.FinalQuality, Result.OriginalBytes, Result.FinalBytes, Result.MemorySavedMB });
+            break;
+        case EBatchAssetKind::Folder:
+            FolderData.Set(Row, { Result.OriginalBytes, Result.FinalBytes, Result.BudgetBytes });
+            break;
+        default:
+            break;
+    }
+}
+
+FTextureOptimizationResult FTextureOptimizationResultTable::GetRow(int32 Row) const
+{
+    FTextureOptimizationResult Result;
+    Result.TextureName = TextureNames[Row];
+    Result.PackageName = PackageNames[Row];
+    Result.OriginalWidth = OriginalWidths[Row];
+    Result.OriginalHeight = OriginalHeights[Row];
+    Result.FinalWidth = FinalWidths[Row];
+    Result.FinalHeight = FinalHeights[Row];
+    Result.TargetResolution = TargetResolutions[Row];
+    Result.VRAMSavedMB = VRAMSavedMB[Row];
+    Result.FileSizeSavedMB = FileSizeSavedMB[Row];
+    Result.bSuccess = IsSuccess(Row);
+    Result.bHadSourceFile = HadSourceFile(Row);
+    Result.bOverBudget = IsOverBudget(Row);
+    Result.bEstimated = IsEstimated(Row);
+    Result.MethodUsed = Methods[Row];
+    Result.Error = Errors[Row];
+    Result.AssetKind = Kinds[Row];
+    Result.OriginalVertices = GetOriginalVertices(Row);
+    Result.FinalVertices = GetFinalVertices(Row);
+    Result.OriginalIndices = GetOriginalIndices(Row);
+    Result.FinalIndices = GetFinalIndices(Row);
+    Result.OriginalBytes = GetOriginalBytes(Row);
+    Result.FinalBytes = GetFinalBytes(Row);
+    Result.OriginalSampleRate = GetOriginalSampleRate(Row);
+    Result.FinalSampleRate = GetFinalSampleRate(Row);
+    Result.OriginalQuality = GetOriginalQuality(Row);
+    Result.FinalQuality = GetFinalQuality(Row);
+    Result.MemorySavedMB = GetMemorySavedMB(Row);
+    Result.BudgetBytes = GetBudgetBytes(Row);
+    return Result;
+}
+
+uint32 FTextureOptimizationResultTable::GetOriginalVertices(int32 Row) const
+{
+    const FMeshRowData* Data = MeshData.Find(Row);
+    return Data ? Data->OriginalVertices : 0;
+}
+
+uint32 FTextureOptimizationResultTable::GetFinalVertices(int32 Row) const
+{
+    const FMeshRowData* Data = MeshData.Find(Row);
+    return Data ? Data->FinalVertices : 0;
+}
+
+uint32 FTextureOptimizationResultTable::GetOriginalIndices(int32 Row) const
+{
+    const FMeshRowData* Data = MeshData.Find(Row);
+    return Data ? Data->OriginalIndices : 0;
+}
+
+uint32 FTextureOptimizationResultTable::GetFinalIndices(int32 Row) const
+{
+    const FMeshRowData* Data = MeshData.Find(Row);
+    return Data ? Data->FinalIndices : 0;
+}
+
+int64 FTextureOptimizationResultTable::GetOriginalBytes(int32 Row) const
+{
+    switch (Kinds[Row])
+    {
+        case EBatchAssetKind::StaticMesh:
+            if (const FMeshRowData* Data = MeshData.Find(Row))
+                return Data->OriginalBytes;
+            break;
+        case EBatchAssetKind::SoundWave:
+            if (const FSoundRowData* Data = SoundData.Find(Row))
+                return Data->OriginalBytes;
+            break;
+        case EBatchAssetKind::Folder:
+            if (const FFolderRowData* Data = FolderData.Find(Row))
+                return Data->OriginalBytes;
+            break;
+        default:
+            break;
+    }
+    return 0;
+}
+
+int64 FTextureOptimizationResultTable::GetFinalBytes(int32 Row) const
+{
+    switch (Kinds[Row])
+    {
+        case EBatchAssetKind::StaticMesh:
+            if (const FMeshRowData* Data = MeshData.Find(Row))
+                return Data->FinalBytes;
+            break;
+        case EBatchAssetKind::SoundWave:
+            if (const FSoundRowData* Data = SoundData.Find(Row))
+                return Data->FinalBytes;
+            break;
+        case EBatchAssetKind::Folder:
+            if (const FFolderRowData* Data = FolderData.Find(Row))
+                return Data->FinalBytes;
+            break;
+        default:
+            break;
+    }
+    return 0;
+}
+
+uint32 FTextureOptimizationResultTable::GetOriginalSampleRate(int32 Row) const
+{
+    const FSoundRowData* Data = SoundData.Find(Row);
+    return Data ? Data->OriginalSampleRate : 0;
+}
+
+uint32 FTextureOptimizationResultTable::GetFinalSampleRate(int32 Row) const
+{
+    const FSoundRowData* Data = SoundData.Find(Row);
+    return Data ? Data->FinalSampleRate : 0;
+}
+
+uint8 FTextureOptimizationResultTable::GetOriginalQuality(int32 Row) const
+{
+    const FSoundRowData* Data = SoundData.Find(Row);
+    return Data ? Data->OriginalQuality : 0;
+}
+
+uint8 FTextureOptimizationResultTable::GetFinalQuality(int32 Row) const
+{
+    const FSoundRowData* Data = SoundData.Find(Row);
+    return Data ? Data->FinalQuality : 0;
+}
+
+float FTextureOptimizationResultTable::GetMemorySavedMB(int32 Row) const
+{
+    const FSoundRowData* Data = SoundData.Find(Row);
+    return Data ? Data->MemorySavedMB : 0.0f;
+}
+
+int64 FTextureOptimizationResultTable::GetBudgetBytes(int32 Row) const
+{
+    const FFolderRowData* Data = FolderData.Find(Row);
+    return Data ? Data->BudgetBytes : 0;
+}
+
+namespace BatchToolsResultTable
+{
+    // Four lanes at a time, double precision for the tail and the final sum
+    static double SumColumn(const TArray<float>& Column)
+    {
+        const float* Data = Column.GetData();
+        const int32 NumValues = Column.Num();
+        const int32 NumVectorized = NumValues & ~3;
+
+        VectorRegister4Float Sum = VectorZeroFloat();
+        for (int32 Index = 0; Index < NumVectorized; Index += 4)
+        {
+            Sum = VectorAdd(Sum, VectorLoad(Data + Index));
+        }
+
+        alignas(16) float Lanes[4];
+        VectorStoreAligned(Sum, Lanes);
+        double Total = (double)Lanes[0] + (double)Lanes[1] + (double)Lanes[2] + (double)Lanes[3];
+
+        for (int32 Index = NumVectorized; Index < NumValues; Index++)
+            Total += Data[Index];
+        return Total;
+    }
+}
+
+FTextureOptimizationTotals FTextureOptimizationResultTable::ComputeTotals() const
+{
+    FTextureOptimizationTotals Totals;
+    Totals.NumRows = Num();
+    Totals.VRAMSavedMB = BatchToolsResultTable::SumColumn(VRAMSavedMB);
+    Totals.FileSizeSavedMB = BatchToolsResultTable::SumColumn(FileSizeSavedMB);
+
+    for (uint8 RowFlags : Flags)
+    {
+        Totals.NumSuccessful += RowFlags & RowFlag_Success;
+        Totals.NumWithSource += (RowFlags & RowFlag_HadSource) >> 1;
+        Totals.NumOverBudget += (RowFlags & RowFlag_OverBudget) >> 2;
+    }
+
+    for (EOptimizationMethod Method : Methods)
+        Totals.MethodCounts[(int32)Method]++;
+
+    for (EOptimizationError Error : Errors)
+        Totals.ErrorCounts[(int32)Error]++;
+
+    for (int32 Row = 0; Row < Kinds.Num(); Row++)
+    {
+        Totals.KindCounts[(int32)Kinds[Row]]++;
+        Totals.KindSuccessCounts[(int32)Kinds[Row]] += Flags[Row] & RowFlag_Success;
+    }
+
+    for (const FSoundRowData& Data : SoundData.Values)
+        Totals.AudioMemorySavedMB += Data.MemorySavedMB;
+
+    return Totals;
+}
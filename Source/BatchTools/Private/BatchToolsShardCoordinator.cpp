@@ -0,0 +1,456 @@
+#include "BatchToolsShardCoordinator.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/App.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlProvider.h"
+#include "PackageTools.h"
+#include "SourceControlHelpers.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#define LOCTEXT_NAMESPACE "FBatchToolsModule"
+
+namespace BatchToolsShards
+{
+    static const TCHAR* PendingDir = TEXT("Pending");
+    static const TCHAR* ClaimedDir = TEXT("Claimed");
+    static const TCHAR* ResultsDir = TEXT("Results");
+    static const FName DimensionsTag(TEXT("Dimensions"));
+
+    static int64 EstimateCost(const FAssetData& Asset)
+    {
+        FString Dimensions;
+        FString WidthString;
+        FString HeightString;
+        if (Asset.GetTagValue(DimensionsTag, Dimensions) && Dimensions.Split(TEXT("x"), &WidthString, &HeightString))
+        {
+            return FMath::Max<int64>(1, (int64)FCString::Atoi(*WidthString) * FCString::Atoi(*HeightString));
+        }
+        return 1024 * 1024;
+    }
+
+    static TSharedRef<FJsonObject> ResultToJson(const FTextureOptimizationResult& Result)
+    {
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        Json->SetStringField(TEXT("TextureName"), Result.TextureName.ToString());
+        Json->SetStringField(TEXT("PackageName"), Result.PackageName.ToString());
+        Json->SetNumberField(TEXT("OriginalWidth"), Result.OriginalWidth);
+        Json->SetNumberField(TEXT("OriginalHeight"), Result.OriginalHeight);
+        Json->SetNumberField(TEXT("FinalWidth"), Result.FinalWidth);
+        Json->SetNumberField(TEXT("FinalHeight"), Result.FinalHeight);
+        Json->SetNumberField(TEXT("TargetResolution"), Result.TargetResolution);
+        Json->SetNumberField(TEXT("VRAMSavedMB"), Result.VRAMSavedMB);
+        Json->SetNumberField(TEXT("FileSizeSavedMB"), Result.FileSizeSavedMB);
+        Json->SetBoolField(TEXT("bSuccess"), Result.bSuccess);
+        Json->SetBoolField(TEXT("bHadSourceFile"), Result.bHadSourceFile);
+        Json->SetBoolField(TEXT("bEstimated"), Result.bEstimated);
+        Json->SetStringField(TEXT("MethodUsed"), LexToString(Result.MethodUsed));
+        Json->SetStringField(TEXT("Error"), LexToString(Result.Error));
+        return Json;
+    }
+
+    static FTextureOptimizationResult ResultFromJson(const TSharedPtr<FJsonObject>& Json)
+    {
+        FTextureOptimizationResult Result;
+        Result.TextureName = FName(*Json->GetStringField(TEXT("TextureName")));
+        Result.PackageName = FName(*Json->GetStringField(TEXT("PackageName")));
+        Result.OriginalWidth = (int32)Json->GetNumberField(TEXT("OriginalWidth"));
+        Result.OriginalHeight = (int32)Json->GetNumberField(TEXT("OriginalHeight"));
+        Result.FinalWidth = (int32)Json->GetNumberField(TEXT("FinalWidth"));
+        Result.FinalHeight = (int32)Json->GetNumberField(TEXT("FinalHeight"));
+        Json->TryGetNumberField(TEXT("TargetResolution"), Result.TargetResolution);
+        Result.VRAMSavedMB = (float)Json->GetNumberField(TEXT("VRAMSavedMB"));
+        Result.FileSizeSavedMB = (float)Json->GetNumberField(TEXT("FileSizeSavedMB"));
+        Result.bSuccess = Json->GetBoolField(TEXT("bSuccess"));
+        Result.bHadSourceFile = Json->GetBoolField(TEXT("bHadSourceFile"));
+        Json->TryGetBoolField(TEXT("bEstimated"), Result.bEstimated);
+        LexTryParseString(Result.MethodUsed, *Json->GetStringField(TEXT("MethodUsed")));
+        LexTryParseString(Result.Error, *Json->GetStringField(TEXT("Error")));
+        return Result;
+    }
+
+    static bool WriteResults(const FString& Filename, const FTextureOptimizationResultTable& Results)
+    {
+        TArray<TSharedPtr<FJsonValue>> Values;
+        Values.Reserve(Results.Num());
+        for (int32 Row = 0; Row < Results.Num(); Row++)
+            Values.Add(MakeShared<FJsonValueObject>(ResultToJson(Results.GetRow(Row))));
+
+        FString Output;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+        if (!FJsonSerializer::Serialize(Values, Writer))
+            return false;
+
+        // Write then rename so the coordinator never reads a partial file
+        const FString TempFilename = Filename + TEXT(".tmp");
+        return FFileHelper::SaveStringToFile(Output, *TempFilename) && IFileManager::Get().Move(*Filename, *TempFilename);
+    }
+
+    static bool ReadResults(const FString& Filename, FTextureOptimizationResultTable& OutResults)
+    {
+        FString Input;
+        if (!FFileHelper::LoadFileToString(Input, *Filename))
+            return false;
+
+        TArray<TSharedPtr<FJsonValue>> Values;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Input);
+        if (!FJsonSerializer::Deserialize(Reader, Values))
+            return false;
+
+        for (const TSharedPtr<FJsonValue>& Value : Values)
+        {
+            const TSharedPtr<FJsonObject>* Object = nullptr;
+            if (Value.IsValid() && Value->TryGetObject(Object))
+                OutResults.Add(ResultFromJson(*Object));
+        }
+        return true;
+    }
+
+    // Checks the packages out, or verifies they are writable when no source control is configured
+    static bool MakePackagesWritable(const TArray<UPackage*>& Packages)
+    {
+        TArray<FString> Filenames;
+        for (const UPackage* Package : Packages)
+        {
+            Filenames.Add(FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension())));
+        }
+
+        if (ISourceControlModule::Get().IsEnabled())
+            return USourceControlHelpers::CheckOutOrAddFiles(Filenames, true);
+
+        for (const FString& Filename : Filenames)
+        {
+            if (IFileManager::Get().IsReadOnly(*Filename))
+                return false;
+        }
+        return true;
+    }
+
+    // Turns every successful row of a shard that was not saved into a failure with no savings
+    static void MarkShardUnsaved(FTextureOptimizationResultTable& Results, EOptimizationError Error)
+    {
+        for (int32 Row = 0; Row < Results.Num(); Row++)
+        {
+            if (!Results.IsSuccess(Row))
+                continue;
+
+            FTextureOptimizationResult Failed = Results.GetRow(Row);
+            Failed.bSuccess = false;
+            Failed.Error = Error;
+            Failed.FinalWidth = Failed.OriginalWidth;
+            Failed.FinalHeight = Failed.OriginalHeight;
+            Failed.VRAMSavedMB = 0.0f;
+            Failed.FileSizeSavedMB = 0.0f;
+            Results.Set(Row, Failed);
+        }
+    }
+
+    static TArray<FString> ListFiles(const FString& Directory)
+    {
+        TArray<FString> Files;
+        IFileManager::Get().FindFiles(Files, *(Directory / TEXT("*.txt")), true, false);
+        Files.Sort();
+        return Files;
+    }
+}
+
+FBatchToolsShardSettings FBatchToolsShardSettings::Load()
+{
+    const TCHAR* Section = TEXT("BatchTools.Sharding");
+    const FString& ConfigFilename = FBatchToolsModule::GetConfigFilename();
+
+    FBatchToolsShardSettings Settings;
+    GConfig->GetInt(Section, TEXT("NumWorkers"), Settings.NumWorkers, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MinAssetsForSharding"), Settings.MinAssetsForSharding, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("ShardsPerWorker"), Settings.ShardsPerWorker, ConfigFilename);
+
+    Settings.NumWorkers = FMath::Max(0, Settings.NumWorkers);
+    Settings.ShardsPerWorker = FMath::Max(1, Settings.ShardsPerWorker);
+    return Settings;
+}
+
+FTextureOptimizationResultTable FBatchToolsShardCoordinator::Run(const TArray<FAssetData>& Assets, EOptimizationMethod Method, int32 TargetResolution, int32 NumWorkers, int32 ShardsPerWorker)
+{
+    FTextureOptimizationResultTable Results;
+    Results.Reserve(Assets.Num());
+    const FString QueueDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("BatchTools") / TEXT("Shards") / FGuid::NewGuid().ToString());
+    IFileManager& FileManager = IFileManager::Get();
+
+    // Workers save the packages, so the editor copy must not hold unsaved changes or be open for editing
+    UAssetEditorSubsystem* AssetEditors = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+    TArray<TPair<int64, const FAssetData*>> Work;
+    for (const FAssetData& Asset : Assets)
+    {
+        UPackage* Package = FindPackage(nullptr, *Asset.PackageName.ToString());
+        UObject* LoadedAsset = Package ? Asset.FastGetAsset(false) : nullptr;
+        const bool bOpenInEditor = LoadedAsset && AssetEditors && AssetEditors->FindEditorsForAsset(LoadedAsset).Num() > 0;
+        if ((Package && Package->IsDirty()) || bOpenInEditor)
+        {
+            FTextureOptimizationResult Skipped;
+            Skipped.TextureName = Asset.AssetName;
+            Skipped.PackageName = Asset.PackageName;
+            Skipped.MethodUsed = Method;
+            Skipped.Error = bOpenInEditor ? EOptimizationError::OpenInEditor : EOptimizationError::UnsavedChanges;
+            Results.Add(Skipped);
+            continue;
+        }
+
+        // Loaded packages read bulk data lazily from their file; load it now and let go of the file
+        // before a worker overwrites it. The package is reloaded from the worker's save afterwards.
+        if (Package)
+        {
+            ResetLoaders(Package);
+        }
+        Work.Emplace(BatchToolsShards::EstimateCost(Asset), &Asset);
+    }
+
+    if (Work.Num() == 0)
+        return Results;
+
+    // Largest textures first, cut into shards of roughly equal cost; workers claim them in order
+    Work.Sort([](const TPair<int64, const FAssetData*>& A, const TPair<int64, const FAssetData*>& B) { return A.Key > B.Key; });
+
+    int64 TotalCost = 0;
+    for (const TPair<int64, const FAssetData*>& Item : Work)
+        TotalCost += Item.Key;
+
+    NumWorkers = FMath::Clamp(NumWorkers, 1, Work.Num());
+    const int32 NumShardsWanted = FMath::Min(Work.Num(), NumWorkers * FMath::Max(1, ShardsPerWorker));
+    const int64 CostPerShard = FMath::Max<int64>(1, TotalCost / NumShardsWanted);
+
+    int32 NumShards = 0;
+    FString ShardContents;
+    int64 ShardCost = 0;
+    for (int32 Index = 0; Index < Work.Num(); Index++)
+    {
+        ShardContents += Work[Index].Value->PackageName.ToString() + LINE_TERMINATOR;
+        ShardCost += Work[Index].Key;
+
+        if (ShardCost >= CostPerShard || Index == Work.Num() - 1)
+        {
+            const FString ShardFile = QueueDirectory / BatchToolsShards::PendingDir / FString::Printf(TEXT("Shard_%05d.txt"), NumShards++);
+            FFileHelper::SaveStringToFile(ShardContents, *ShardFile);
+            ShardContents.Reset();
+            ShardCost = 0;
+        }
+    }
+
+    FileManager.MakeDirectory(*(QueueDirectory / BatchToolsShards::ClaimedDir), true);
+    FileManager.MakeDirectory(*(QueueDirectory / BatchToolsShards::ResultsDir), true);
+
+    const FString Executable = FPlatformProcess::GenerateApplicationPath(TEXT("UnrealEditor-Cmd"), FApp::GetBuildConfiguration());
+    const FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+    const FString WorkerParams = FString::Printf(TEXT("\"%s\" -run=BatchTools -ShardQueue=\"%s\" -Method=%s -Target=%d -unattended -nullrhi -nosplash -nopause -stdout -FullStdOutLogOutput"),
+        *ProjectFile, *QueueDirectory, LexToString(Method), TargetResolution);
+
+    TArray<FProcHandle> Workers;
+    for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; WorkerIndex++)
+    {
+        FProcHandle Handle = FPlatformProcess::CreateProc(*Executable, *WorkerParams, false, true, true, nullptr, -1, nullptr, nullptr);
+        if (Handle.IsValid())
+            Workers.Add(Handle);
+        else
+            UE_LOG(LogBatchTools, Warning, TEXT("Could not launch shard worker %d (%s)"), WorkerIndex, *Executable);
+    }
+
+    UE_LOG(LogBatchTools, Log, TEXT("Sharded batch: %d textures in %d shards across %d workers (%s)"), Work.Num(), NumShards, Workers.Num(), *QueueDirectory);
+
+    FScopedSlowTask SlowTask(NumShards, LOCTEXT("ShardedOptimization", "Optimizing Textures in Worker Processes..."));
+    SlowTask.MakeDialog(true);
+
+    int32 NumCompleted = 0;
+    bool bCancelled = false;
+    while (Workers.Num() > 0)
+    {
+        const int32 NumResults = BatchToolsShards::ListFiles(QueueDirectory / BatchToolsShards::ResultsDir).Num();
+        if (NumResults > NumCompleted)
+        {
+            SlowTask.EnterProgressFrame(NumResults - NumCompleted, FText::Format(LOCTEXT("ShardProgress", "{0}/{1} shards complete"), FText::AsNumber(NumResults), FText::AsNumber(NumShards)));
+            NumCompleted = NumResults;
+        }
+
+        if (SlowTask.ShouldCancel())
+        {
+            bCancelled = true;
+            for (FProcHandle& Handle : Workers)
+                FPlatformProcess::TerminateProc(Handle, true);
+        }
+
+        for (int32 WorkerIndex = Workers.Num() - 1; WorkerIndex >= 0; WorkerIndex--)
+        {
+            if (!FPlatformProcess::IsProcRunning(Workers[WorkerIndex]))
+            {
+                FPlatformProcess::CloseProc(Workers[WorkerIndex]);
+                Workers.RemoveAtSwap(WorkerIndex);
+            }
+        }
+
+        FPlatformProcess::Sleep(0.25f);
+    }
+
+    // Every claimed shard may have saved packages, including one whose worker died before writing
+    // its results, so reloads follow the claimed shard lists rather than the rows that came back
+    TMap<FString, TArray<FName>> ClaimedPackages;
+    for (const FString& ClaimedFile : BatchToolsShards::ListFiles(QueueDirectory / BatchToolsShards::ClaimedDir))
+    {
+        FString ShardContents;
+        if (FFileHelper::LoadFileToString(ShardContents, *(QueueDirectory / BatchToolsShards::ClaimedDir / ClaimedFile)))
+        {
+            TArray<FString> PackageNames;
+            ShardContents.ParseIntoArrayLines(PackageNames);
+            TArray<FName>& ShardPackages = ClaimedPackages.Add(ClaimedFile);
+            for (const FString& PackageName : PackageNames)
+                ShardPackages.Add(FName(*PackageName));
+        }
+    }
+
+    // Merge in shard order
+    TSet<FName> CompletedPackages;
+    for (const FString& ResultFile : BatchToolsShards::ListFiles(QueueDirectory / BatchToolsShards::ResultsDir))
+    {
+        if (!BatchToolsShards::ReadResults(QueueDirectory / BatchToolsShards::ResultsDir / ResultFile, Results))
+            UE_LOG(LogBatchTools, Warning, TEXT("Could not read shard results %s"), *ResultFile);
+
+        if (const TArray<FName>* ShardPackages = ClaimedPackages.Find(ResultFile))
+            CompletedPackages.Append(*ShardPackages);
+    }
+
+    // Anything without results crashed a worker or was cancelled
+    for (const TPair<int64, const FAssetData*>& Item : Work)
+    {
+        if (!CompletedPackages.Contains(Item.Value->PackageName))
+        {
+            FTextureOptimizationResult Failed;
+            Failed.TextureName = Item.Value->AssetName;
+            Failed.PackageName = Item.Value->PackageName;
+            Failed.MethodUsed = Method;
+            Failed.Error = bCancelled ? EOptimizationError::Cancelled : EOptimizationError::NoWorkerResult;
+            Results.Add(Failed);
+        }
+    }
+
+    // Pick up what the workers saved
+    TArray<UPackage*> PackagesToReload;
+    for (const TPair<FString, TArray<FName>>& Shard : ClaimedPackages)
+    {
+        for (FName PackageName : Shard.Value)
+        {
+            if (UPackage* Package = FindPackage(nullptr, *PackageName.ToString()))
+                PackagesToReload.Add(Package);
+        }
+    }
+    if (PackagesToReload.Num() > 0)
+    {
+        UPackageTools::ReloadPackages(PackagesToReload);
+    }
+
+    FileManager.DeleteDirectory(*QueueDirectory, false, true);
+    return Results;
+}
+
+int32 FBatchToolsShardCoordinator::RunWorker(FBatchToolsModule& Module, const FString& QueueDirectory, EOptimizationMethod Method, int32 TargetResolution)
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    // Commandlets do not connect to source control on their own
+    if (ISourceControlModule::Get().IsEnabled())
+    {
+        ISourceControlModule::Get().GetProvider().Init(true);
+    }
+
+    IFileManager& FileManager = IFileManager::Get();
+    const FString PendingDirectory = QueueDirectory / BatchToolsShards::PendingDir;
+    int32 NumShardsProcessed = 0;
+
+    while (true)
+    {
+        TArray<FString> PendingShards = BatchToolsShards::ListFiles(PendingDirectory);
+        if (PendingShards.Num() == 0)
+            break;
+
+        // Claim the next shard; losing the race to another worker just moves on to the next one
+        FString ClaimedShard;
+        for (const FString& Shard : PendingShards)
+        {
+            const FString ClaimedPath = QueueDirectory / BatchToolsShards::ClaimedDir / Shard;
+            if (FileManager.Move(*ClaimedPath, *(PendingDirectory / Shard), false, false, false, true))
+            {
+                ClaimedShard = Shard;
+                break;
+            }
+        }
+        if (ClaimedShard.IsEmpty())
+        {
+            // Every pending shard was claimed by another worker between the listing and the move
+            FPlatformProcess::Sleep(0.05f);
+            continue;
+        }
+
+        FString ShardContents;
+        FFileHelper::LoadFileToString(ShardContents, *(QueueDirectory / BatchToolsShards::ClaimedDir / ClaimedShard));
+        TArray<FString> PackageNames;
+        ShardContents.ParseIntoArrayLines(PackageNames);
+
+        TArray<FAssetData> Assets;
+        for (const FString& PackageName : PackageNames)
+        {
+            TArray<FAssetData> PackageAssets;
+            AssetRegistry.GetAssetsByPackageName(FName(*PackageName), PackageAssets);
+            Assets.Append(PackageAssets);
+        }
+
+        FTextureOptimizationResultTable Results = Module.ProcessTextures(Assets, Method, TargetResolution);
+
+        TArray<UPackage*> DirtyPackages;
+        for (const FAssetData& Asset : Assets)
+        {
+            UPackage* Package = FindPackage(nullptr, *Asset.PackageName.ToString());
+            if (Package && Package->IsDirty())
+                DirtyPackages.Add(Package);
+        }
+
+        // Nothing in a shard is saved unless all of its packages can be written
+        if (DirtyPackages.Num() > 0 && !BatchToolsShards::MakePackagesWritable(DirtyPackages))
+        {
+            UE_LOG(LogBatchTools, Error, TEXT("Shard %s: could not check out %d modified packages, nothing was saved"), *ClaimedShard, DirtyPackages.Num());
+            BatchToolsShards::MarkShardUnsaved(Results, EOptimizationError::CheckoutFailed);
+        }
+        else if (DirtyPackages.Num() > 0 && !UEditorLoadingAndSavingUtils::SavePackages(DirtyPackages, false))
+        {
+            // SavePackages does not say which package failed, so no row in the shard claims a saving
+            UE_LOG(LogBatchTools, Error, TEXT("Shard %s: failed to save modified packages"), *ClaimedShard);
+            BatchToolsShards::MarkShardUnsaved(Results, EOptimizationError::SaveFailed);
+        }
+
+        if (!BatchToolsShards::WriteResults(QueueDirectory / BatchToolsShards::ResultsDir / ClaimedShard, Results))
+        {
+            UE_LOG(LogBatchTools, Error, TEXT("Shard %s: failed to write results"), *ClaimedShard);
+        }
+
+        // Keep the worker's footprint flat across shards
+        CollectGarbage(RF_NoFlags);
+        NumShardsProcessed++;
+
+        UE_LOG(LogBatchTools, Display, TEXT("Shard %s done: %d textures"), *ClaimedShard, Results.Num());
+    }
+
+    return NumShardsProcessed;
+}
+
+#undef LOCTEXT_NAMESPACE
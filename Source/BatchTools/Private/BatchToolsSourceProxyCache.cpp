@@ -0,0 +1,393 @@
+#include "BatchToolsSourceProxyCache.h"
+#include "BatchToolsModule.h"
+#include "Engine/Texture.h"
+#include "EditorFramework/AssetImportData.h"
+#include "ImageCore.h"
+#include "ImageUtils.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Memory/MemoryView.h"
+#include "Misc/Compression.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace BatchToolsSourceProxy
+{
+    static const uint32 ProxyMagic = 0x58505442; // 'BTPX'
+    static const int32 ProxyVersion = 1;
+    static const TCHAR* ProxyExtension = TEXT("btprx");
+
+    static void SerializeHeader(FArchive& Ar, uint8& Format, uint8& GammaSpace, TArray<FIntPoint>& Sizes, TArray<int64>& Offsets, TArray<int64>& CompressedSizes, TArray<int64>& UncompressedSizes)
+    {
+        int32 NumLevels = Sizes.Num();
+        Ar << Format << GammaSpace << NumLevels;
+
+        if (Ar.IsLoading())
+        {
+            if (NumLevels < 0 || NumLevels > 32)
+            {
+                Ar.SetError();
+                return;
+            }
+            Sizes.SetNum(NumLevels);
+            Offsets.SetNum(NumLevels);
+            CompressedSizes.SetNum(NumLevels);
+            UncompressedSizes.SetNum(NumLevels);
+        }
+
+        for (int32 Level = 0; Level < NumLevels; Level++)
+        {
+            Ar << Sizes[Level].X << Sizes[Level].Y << Offsets[Level] << CompressedSizes[Level] << UncompressedSizes[Level];
+        }
+    }
+}
+
+FBatchToolsSourceProxySettings FBatchToolsSourceProxySettings::Load()
+{
+    const TCHAR* Section = TEXT("BatchTools.SourceProxy");
+    const FString& ConfigFilename = FBatchToolsModule::GetConfigFilename();
+
+    FBatchToolsSourceProxySettings Settings;
+    GConfig->GetBool(Section, TEXT("bEnabled"), Settings.bEnabled, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MaxCacheSizeMB"), Settings.MaxCacheSizeMB, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MinLevelSize"), Settings.MinLevelSize, ConfigFilename);
+    GConfig->GetBool(Section, TEXT("bWriteSource"), Settings.bWriteSource, ConfigFilename);
+
+    Settings.MaxCacheSizeMB = FMath::Max(0, Settings.MaxCacheSizeMB);
+    Settings.MinLevelSize = FMath::Max(1, Settings.MinLevelSize);
+    return Settings;
+}
+
+FBatchToolsSourceProxyCache::FBatchToolsSourceProxyCache(const FBatchToolsSourceProxySettings& InSettings)
+    : Settings(InSettings)
+{
+}
+
+FString FBatchToolsSourceProxyCache::GetCacheDirectory()
+{
+    return FPaths::ProjectSavedDir() / TEXT("BatchTools") / TEXT("SourceProxies");
+}
+
+FString FBatchToolsSourceProxyCache::GetProxyFilename(const FMD5Hash& Hash) const
+{
+    return GetCacheDirectory() / FString::Printf(TEXT("%s.%s"), *LexToString(Hash), BatchToolsSourceProxy::ProxyExtension);
+}
+
+bool FBatchToolsSourceProxyCache::FindSourceSize(const UTexture* Texture, FIntPoint& OutSize)
+{
+    FSourceKey Key;
+    FProxyHeader Header;
+    if (!Settings.bEnabled || !ResolveSource(Texture, Key) || !ReadHeader(GetProxyFilename(Key.Hash), Header))
+        return false;
+
+    OutSize = FIntPoint(Header.Levels[0].Width, Header.Levels[0].Height);
+    return true;
+}
+
+bool FBatchToolsSourceProxyCache::Resample(const UTexture* Texture, int32 Width, int32 Height, FImage& OutImage)
+{
+    FSourceKey Key;
+    if (Width <= 0 || Height <= 0 || !ResolveSource(Texture, Key))
+        return false;
+
+    const FString ProxyFilename = GetProxyFilename(Key.Hash);
+    FImage Level;
+    bool bFound = false;
+
+    FProxyHeader Header;
+    if (Settings.bEnabled && ReadHeader(ProxyFilename, Header))
+    {
+        TArray<FIntPoint> LevelSizes;
+        for (const FLevelInfo& Info : Header.Levels)
+            LevelSizes.Emplace(Info.Width, Info.Height);
+
+        bFound = ReadLevel(ProxyFilename, Header, ChooseLevel(LevelSizes, Width, Height), Level);
+        if (bFound)
+        {
+            // Modification time doubles as the last access time for trimming
+            IFileManager::Get().SetTimeStamp(*ProxyFilename, FDateTime::UtcNow());
+            NumHits++;
+        }
+    }
+
+    if (!bFound)
+    {
+        TArray<FImage> Levels;
+        if (!BuildProxy(Key, Levels))
+            return false;
+
+        TArray<FIntPoint> LevelSizes;
+        for (const FImage& Image : Levels)
+            LevelSizes.Emplace(Image.SizeX, Image.SizeY);
+
+        Level = MoveTemp(Levels[ChooseLevel(LevelSizes, Width, Height)]);
+        NumMisses++;
+    }
+
+    if (Level.SizeX == Width && Level.SizeY == Height)
+    {
+        OutImage = MoveTemp(Level);
+    }
+    else
+    {
+        Level.ResizeTo(OutImage, Width, Height, Level.Format, Level.GammaSpace);
+    }
+    return true;
+}
+
+bool FBatchToolsSourceProxyCache::ResolveSource(const UTexture* Texture, FSourceKey& OutKey)
+{
+    if (!Texture || !Texture->AssetImportData || Texture->AssetImportData->SourceData.SourceFiles.Num() == 0)
+        return false;
+
+    OutKey.Filename = Texture->AssetImportData->GetFirstFilename();
+    const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*OutKey.Filename);
+    if (OutKey.Filename.IsEmpty() || Timestamp == FDateTime::MinValue())
+        return false;
+
+    // The hash recorded at import is only trusted while the file is unchanged since then
+    const FAssetImportInfo::FSourceFile& SourceFile = Texture->AssetImportData->SourceData.SourceFiles[0];
+    if (SourceFile.FileHash.IsValid() && SourceFile.Timestamp == Timestamp)
+    {
+        OutKey.Hash = SourceFile.FileHash;
+        return true;
+    }
+
+    const TPair<FDateTime, FMD5Hash>* Computed = ComputedHashes.Find(OutKey.Filename);
+    if (Computed && Computed->Key == Timestamp)
+    {
+        OutKey.Hash = Computed->Value;
+        return true;
+    }
+
+    OutKey.Hash = FMD5Hash::HashFile(*OutKey.Filename);
+    if (!OutKey.Hash.IsValid())
+        return false;
+
+    ComputedHashes.Add(OutKey.Filename, TPair<FDateTime, FMD5Hash>(Timestamp, OutKey.Hash));
+    return true;
+}
+
+bool FBatchToolsSourceProxyCache::BuildProxy(const FSourceKey& Key, TArray<FImage>& OutLevels)
+{
+    FImage Source;
+    if (!FImageUtils::LoadImage(*Key.Filename, Source) || Source.NumSlices != 1)
+    {
+        UE_LOG(LogBatchTools, Warning, TEXT("Could not decode source file %s"), *Key.Filename);
+        return false;
+    }
+
+    OutLevels.Reset();
+    OutLevels.Add(MoveTemp(Source));
+    if (!Settings.bEnabled)
+        return true;
+
+    // Each level halves the previous one, so resampling never starts from more than twice the target
+    while (FMath::Max(OutLevels.Last().SizeX, OutLevels.Last().SizeY) > Settings.MinLevelSize)
+    {
+        const FImage& Previous = OutLevels.Last();
+        FImage Next;
+        Previous.ResizeTo(Next, FMath::Max(1, Previous.SizeX / 2), FMath::Max(1, Previous.SizeY / 2), Previous.Format, Previous.GammaSpace);
+        OutLevels.Add(MoveTemp(Next));
+    }
+
+    uint8 Format = (uint8)OutLevels[0].Format;
+    uint8 GammaSpace = (uint8)OutLevels[0].GammaSpace;
+    TArray<FIntPoint> Sizes;
+    TArray<int64> Offsets;
+    TArray<int64> CompressedSizes;
+    TArray<int64> UncompressedSizes;
+    TArray<TArray64<uint8>> Blobs;
+
+    int64 Offset = 0;
+    for (const FImage& Image : OutLevels)
+    {
+        const int64 RawSize = Image.RawData.Num();
+        TArray64<uint8>& Blob = Blobs.AddDefaulted_GetRef();
+
+        // Oodle takes 32-bit sizes; larger levels and incompressible data are stored raw
+        bool bCompressed = false;
+        if (RawSize < MAX_int32)
+        {
+            int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, (int32)RawSize);
+            Blob.SetNumUninitialized(CompressedSize);
+            bCompressed = FCompression::CompressMemory(NAME_Oodle, Blob.GetData(), CompressedSize, Image.RawData.GetData(), (int32)RawSize)
+                && CompressedSize < RawSize;
+            if (bCompressed)
+                Blob.SetNum(CompressedSize, EAllowShrinking::No);
+        }
+        if (!bCompressed)
+        {
+            Blob.Reset();
+            Blob.Append(Image.RawData.GetData(), RawSize);
+        }
+
+        Sizes.Emplace(Image.SizeX, Image.SizeY);
+        Offsets.Add(Offset);
+        CompressedSizes.Add(Blob.Num());
+        UncompressedSizes.Add(RawSize);
+        Offset += Blob.Num();
+    }
+
+    TArray64<uint8> Bytes;
+    FMemoryWriter64 Ar(Bytes);
+    uint32 Magic = BatchToolsSourceProxy::ProxyMagic;
+    int32 Version = BatchToolsSourceProxy::ProxyVersion;
+    Ar << Magic << Version;
+    BatchToolsSourceProxy::SerializeHeader(Ar, Format, GammaSpace, Sizes, Offsets, CompressedSizes, UncompressedSizes);
+    for (const TArray64<uint8>& Blob : Blobs)
+        Bytes.Append(Blob.GetData(), Blob.Num());
+
+    // Written under a temporary name so a cancelled batch never leaves a truncated proxy
+    const FString ProxyFilename = GetProxyFilename(Key.Hash);
+    const FString TempFilename = ProxyFilename + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempFilename) || !IFileManager::Get().Move(*ProxyFilename, *TempFilename, true, true))
+    {
+        UE_LOG(LogBatchTools, Warning, TEXT("Could not write source proxy %s"), *ProxyFilename);
+        IFileManager::Get().Delete(*TempFilename, false, false, true);
+        return true;
+    }
+
+    TrimCache();
+    return true;
+}
+
+bool FBatchToolsSourceProxyCache::ReadHeader(const FString& ProxyFilename, FProxyHeader& OutHeader) const
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.FileExists(*ProxyFilename))
+        return false;
+
+    FOpenMappedResult MappedFile = PlatformFile.OpenMappedEx(*ProxyFilename);
+    if (MappedFile.HasError())
+        return false;
+
+    TUniquePtr<IMappedFileHandle> Handle = MappedFile.StealValue();
+    TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, Handle->GetFileSize()));
+    if (!Region.IsValid())
+        return false;
+
+    FMemoryReaderView Ar(FMemoryView(Region->GetMappedPtr(), (uint64)Region->GetMappedSize()));
+
+    uint32 Magic = 0;
+    int32 Version = 0;
+    Ar << Magic << Version;
+    if (Magic != BatchToolsSourceProxy::ProxyMagic || Version != BatchToolsSourceProxy::ProxyVersion)
+        return false;
+
+    TArray<FIntPoint> Sizes;
+    TArray<int64> Offsets;
+    TArray<int64> CompressedSizes;
+    TArray<int64> UncompressedSizes;
+    BatchToolsSourceProxy::SerializeHeader(Ar, OutHeader.Format, OutHeader.GammaSpace, Sizes, Offsets, CompressedSizes, UncompressedSizes);
+    if (Ar.IsError() || Sizes.Num() == 0)
+        return false;
+
+    // Offsets are relative to the end of the header
+    const int64 DataStart = Ar.Tell();
+    OutHeader.Levels.Reset(Sizes.Num());
+    for (int32 Level = 0; Level < Sizes.Num(); Level++)
+    {
+        FLevelInfo& Info = OutHeader.Levels.AddDefaulted_GetRef();
+        Info.Width = Sizes[Level].X;
+        Info.Height = Sizes[Level].Y;
+        Info.Offset = DataStart + Offsets[Level];
+        Info.CompressedSize = CompressedSizes[Level];
+        Info.UncompressedSize = UncompressedSizes[Level];
+
+        if (Info.Offset < DataStart || Info.Offset + Info.CompressedSize > Region->GetMappedSize())
+        {
+            UE_LOG(LogBatchTools, Warning, TEXT("Source proxy %s is corrupt, it will be rebuilt"), *ProxyFilename);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FBatchToolsSourceProxyCache::ReadLevel(const FString& ProxyFilename, const FProxyHeader& Header, int32 LevelIndex, FImage& OutLevel) const
+{
+    if (!Header.Levels.IsValidIndex(LevelIndex))
+        return false;
+
+    FOpenMappedResult MappedFile = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*ProxyFilename);
+    if (MappedFile.HasError())
+        return false;
+
+    // Only the pages of the requested level are touched
+    const FLevelInfo& Info = Header.Levels[LevelIndex];
+    TUniquePtr<IMappedFileHandle> Handle = MappedFile.StealValue();
+    TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(Info.Offset, Info.CompressedSize));
+    if (!Region.IsValid())
+        return false;
+
+    OutLevel.Init(Info.Width, Info.Height, (ERawImageFormat::Type)Header.Format, (EGammaSpace)Header.GammaSpace);
+    if (OutLevel.RawData.Num() != Info.UncompressedSize)
+        return false;
+
+    if (Info.CompressedSize == Info.UncompressedSize)
+    {
+        FMemory::Memcpy(OutLevel.RawData.GetData(), Region->GetMappedPtr(), Info.UncompressedSize);
+        return true;
+    }
+
+    return FCompression::UncompressMemory(NAME_Oodle, OutLevel.RawData.GetData(), (int32)Info.UncompressedSize,
+                                          Region->GetMappedPtr(), (int32)Info.CompressedSize);
+}
+
+int32 FBatchToolsSourceProxyCache::ChooseLevel(const TArray<FIntPoint>& LevelSizes, int32 Width, int32 Height)
+{
+    int32 Chosen = 0;
+    for (int32 Level = 1; Level < LevelSizes.Num(); Level++)
+    {
+        if (LevelSizes[Level].X < Width || LevelSizes[Level].Y < Height)
+            break;
+        Chosen = Level;
+    }
+    return Chosen;
+}
+
+void FBatchToolsSourceProxyCache::TrimCache() const
+{
+    struct FProxyFile
+    {
+        FString Filename;
+        int64 Size = 0;
+        FDateTime LastAccess;
+    };
+
+    TArray<FProxyFile> Files;
+    int64 TotalBytes = 0;
+    IFileManager::Get().IterateDirectoryStat(*GetCacheDirectory(), [&Files, &TotalBytes](const TCHAR* Filename, const FFileStatData& StatData)
+    {
+        if (!StatData.bIsDirectory && FPaths::GetExtension(Filename) == BatchToolsSourceProxy::ProxyExtension)
+        {
+            Files.Add({ Filename, StatData.FileSize, StatData.ModificationTime });
+            TotalBytes += StatData.FileSize;
+        }
+        return true;
+    });
+
+    const int64 MaxBytes = (int64)Settings.MaxCacheSizeMB * 1024 * 1024;
+    if (TotalBytes <= MaxBytes)
+        return;
+
+    Files.Sort([](const FProxyFile& A, const FProxyFile& B) { return A.LastAccess < B.LastAccess; });
+    int32 NumDeleted = 0;
+    for (const FProxyFile& File : Files)
+    {
+        if (TotalBytes <= MaxBytes)
+            break;
+        if (IFileManager::Get().Delete(*File.Filename, false, false, true))
+        {
+            TotalBytes -= File.Size;
+            NumDeleted++;
+        }
+    }
+
+    UE_LOG(LogBatchTools, Log, TEXT("Source proxy cache trimmed: %d proxies removed, %lld MB kept"), NumDeleted, TotalBytes / (1024 * 1024));
+}
@@ -0,0 +1,263 @@
+#include "BatchToolsStreamingSimulator.h"
+#include "BatchToolsModule.h"
+#include "BatchToolsTextureIndex.h"
+#include "AssetRegistry/AssetData.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Engine/Texture.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureDefines.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+#include "PixelFormat.h"
+
+bool FStreamingScreenSizeBucket::Parse(const FString& BucketText, FStreamingScreenSizeBucket& OutBucket)
+{
+    OutBucket = FStreamingScreenSizeBucket();
+    const TCHAR* Stream = *BucketText;
+
+    if (!FParse::Value(Stream, TEXT("ScreenSizePixels="), OutBucket.ScreenSizePixels) || OutBucket.ScreenSizePixels <= 0)
+        return false;
+    FParse::Value(Stream, TEXT("Weight="), OutBucket.Weight);
+
+    return OutBucket.Weight > 0.0f;
+}
+
+FStreamingSimulationSettings FStreamingSimulationSettings::FromEngineDefaults()
+{
+    FStreamingSimulationSettings Settings;
+
+    if (IConsoleVariable* PoolSizeCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Streaming.PoolSize")))
+    {
+        if (PoolSizeCVar->GetInt() > 0)
+            Settings.PoolSizeMB = (float)PoolSizeCVar->GetInt();
+    }
+
+    if (IConsoleVariable* VTScaleCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.VT.PoolSizeScale")))
+    {
+        Settings.VirtualTexturePoolSizeMB *= FMath::Max(0.0f, VTScaleCVar->GetFloat());
+    }
+
+    TArray<FString> BucketStrings;
+    GConfig->GetArray(TEXT("BatchTools.Streaming"), TEXT("ScreenSizes"), BucketStrings, FBatchToolsModule::GetConfigFilename());
+    for (const FString& BucketString : BucketStrings)
+    {
+        FStreamingScreenSizeBucket Bucket;
+        if (FStreamingScreenSizeBucket::Parse(BucketString, Bucket))
+            Settings.ScreenSizeDistribution.Add(Bucket);
+        else
+            UE_LOG(LogBatchTools, Warning, TEXT("Ignoring screen size bucket without a size or weight: %s"), *BucketString);
+    }
+
+    if (Settings.ScreenSizeDistribution.Num() > 0)
+        return Settings;
+
+    // Most textures cover a small part of the screen, a few fill it
+    Settings.ScreenSizeDistribution.Add({ 128, 0.35f });
+    Settings.ScreenSizeDistribution.Add({ 256, 0.30f });
+    Settings.ScreenSizeDistribution.Add({ 512, 0.20f });
+    Settings.ScreenSizeDistribution.Add({ 1024, 0.10f });
+    Settings.ScreenSizeDistribution.Add({ 2048, 0.05f });
+
+    return Settings;
+}
+
+FStreamingSimulationTexture FBatchToolsStreamingSimulator::GatherTexture(UTexture* Texture)
+{
+    FStreamingSimulationTexture SimTexture;
+    if (!Texture)
+        return SimTexture;
+
+    SimTexture.Width = Texture->GetSurfaceWidth();
+    SimTexture.Height = Texture->GetSurfaceHeight();
+    SimTexture.bVirtualTexture = Texture->VirtualTextureStreaming;
+    SimTexture.bNeverStream = Texture->NeverStream;
+    SimTexture.LODBias = FMath::Max(0, Texture->LODBias);
+
+    if (UTexture2D* Texture2D = Cast<UTexture2D>(Texture))
+    {
+        const FTexturePlatformData* PlatformData = Texture2D->GetPlatformData();
+        if (PlatformData && PlatformData->Mips.Num() > 0 && PlatformData->PixelFormat != PF_Unknown)
+        {
+            const FPixelFormatInfo& FormatInfo = GPixelFormats[PlatformData->PixelFormat];
+            for (const FTexture2DMipMap& Mip : PlatformData->Mips)
+            {
+                const int64 BlocksX = FMath::DivideAndRoundUp(FMath::Max(1, Mip.SizeX), FormatInfo.BlockSizeX);
+                const int64 BlocksY = FMath::DivideAndRoundUp(FMath::Max(1, Mip.SizeY), FormatInfo.BlockSizeY);
+                SimTexture.MipSizes.Add(BlocksX * BlocksY * FormatInfo.BlockBytes);
+            }
+        }
+    }
+
+    // Same 1 byte per pixel estimate as CalculateFileSizeMB when there is no platform data to read
+    if (SimTexture.MipSizes.Num() == 0)
+    {
+        SimTexture.MipSizes = BuildMipSizes(SimTexture.Width, SimTexture.Height, 1.0);
+    }
+
+    return SimTexture;
+}
+
+FStreamingSimulationTexture FBatchToolsStreamingSimulator::GatherTextureFromTags(const FAssetData& Asset)
+{
+    const FTextureIndexEntry Entry = FBatchToolsTextureIndex::ReadAssetTags(Asset);
+
+    FStreamingSimulationTexture SimTexture;
+    SimTexture.Width = Entry.Width;
+    SimTexture.Height = Entry.Height;
+    SimTexture.LODBias = Entry.LODBias;
+    Asset.GetTagValue(TEXT("VirtualTextureStreaming"), SimTexture.bVirtualTexture);
+    Asset.GetTagValue(TEXT("NeverStream"), SimTexture.bNeverStream);
+
+    // Without a format tag this falls back to the same 1 byte per pixel as GatherTexture
+    if (Entry.Width > 0 && Entry.Height > 0)
+    {
+        SimTexture.MipSizes = FBatchToolsTextureIndex::EstimateMipSizes(Entry.Width, Entry.Height, Entry.Format);
+    }
+
+    return SimTexture;
+}
+
+TArray<int64> FBatchToolsStreamingSimulator::BuildMipSizes(int32 Width, int32 Height, double BytesPerPixel)
+{
+    TArray<int64> MipSizes;
+    int32 MipWidth = FMath::Max(1, Width);
+    int32 MipHeight = FMath::Max(1, Height);
+
+    while (true)
+    {
+        MipSizes.Add(FMath::Max<int64>(1, (int64)((double)MipWidth * (double)MipHeight * BytesPerPixel)));
+        if (MipWidth == 1 && MipHeight == 1)
+            break;
+
+        MipWidth = FMath::Max(1, MipWidth / 2);
+        MipHeight = FMath::Max(1, MipHeight / 2);
+    }
+
+    return MipSizes;
+}
+
+TArray<int64> FBatchToolsStreamingSimulator::GetOptimizedMipSizes(const FStreamingSimulationTexture& Texture, int32 FinalWidth, int32 FinalHeight)
+{
+    if (FinalWidth <= 0 || FinalHeight <= 0 || Texture.MipSizes.Num() == 0)
+        return Texture.MipSizes;
+
+    // LOD bias keeps the original chain minus its top mips
+    for (int32 DroppedMips = 0; DroppedMips < Texture.MipSizes.Num(); DroppedMips++)
+    {
+        const int32 MipWidth = FMath::Max(1, Texture.Width >> DroppedMips);
+        const int32 MipHeight = FMath::Max(1, Texture.Height >> DroppedMips);
+        if (MipWidth == FinalWidth && MipHeight == FinalHeight)
+        {
+            return TArray<int64>(Texture.MipSizes.GetData() + DroppedMips, Texture.MipSizes.Num() - DroppedMips);
+        }
+    }
+
+    // Proportional reimport builds a new chain at the same cost per pixel
+    const double SourcePixels = FMath::Max(1.0, (double)Texture.Width * (double)Texture.Height);
+    const double BytesPerPixel = (double)Texture.MipSizes[0] / SourcePixels;
+    return BuildMipSizes(FinalWidth, FinalHeight, BytesPerPixel);
+}
+
+double FBatchToolsStreamingSimulator::CalculateExpectedResidentBytes(const TArray<int64>& MipSizes, int32 Width, int32 Height, const FStreamingSimulationTexture& Texture, const FStreamingSimulationSettings& Settings)
+{
+    if (MipSizes.Num() == 0)
+        return 0.0;
+
+    double TotalChainBytes = 0.0;
+    for (int64 MipSize : MipSizes)
+        TotalChainBytes += (double)MipSize;
+
+    if (Texture.bNeverStream || Settings.ScreenSizeDistribution.Num() == 0)
+        return TotalChainBytes;
+
+    const int32 MaxDimension = FMath::Max(1, FMath::Max(Width, Height));
+    double WeightedBytes = 0.0;
+    double TotalWeight = 0.0;
+
+    for (const FStreamingScreenSizeBucket& Bucket : Settings.ScreenSizeDistribution)
+    {
+        if (Bucket.Weight <= 0.0f)
+            continue;
+
+        // Highest mip the streamer would request for this on-screen size
+        int32 WantedMip = 0;
+        const int32 ScreenSize = FMath::Max(1, Bucket.ScreenSizePixels);
+        if (MaxDimension > ScreenSize)
+        {
+            WantedMip = FMath::CeilToInt(FMath::Log2((double)MaxDimension / (double)ScreenSize));
+        }
+        WantedMip = FMath::Clamp(WantedMip, 0, MipSizes.Num() - 1);
+
+        double ResidentBytes = 0.0;
+        if (Texture.bVirtualTexture)
+        {
+            // VT keeps pages of the sampled mip resident, not the whole chain below it
+            ResidentBytes = (double)MipSizes[WantedMip];
+        }
+        else
+        {
+            for (int32 MipIndex = WantedMip; MipIndex < MipSizes.Num(); MipIndex++)
+                ResidentBytes += (double)MipSizes[MipIndex];
+        }
+
+        WeightedBytes += ResidentBytes * Bucket.Weight;
+        TotalWeight += Bucket.Weight;
+    }
+
+    return TotalWeight > 0.0 ? WeightedBytes / TotalWeight : TotalChainBytes;
+}
+
+FStreamingSimulationReport FBatchToolsStreamingSimulator::Simulate(const TArray<FStreamingSimulationTexture>& Textures, const FTextureOptimizationResultTable& Results, const FStreamingSimulationSettings& Settings)
+{
+    check(Textures.Num() == Results.Num());
+
+    FStreamingSimulationReport Report;
+    Report.NumTextures = Textures.Num();
+    Report.PoolSizeMB = Settings.PoolSizeMB;
+    Report.VirtualTexturePoolSizeMB = Settings.VirtualTexturePoolSizeMB;
+
+    TArray<double> BeforeBytes;
+    TArray<double> AfterBytes;
+    BeforeBytes.SetNumZeroed(Textures.Num());
+    AfterBytes.SetNumZeroed(Textures.Num());
+
+    ParallelFor(Textures.Num(), [&](int32 Index)
+    {
+        const FStreamingSimulationTexture& Texture = Textures[Index];
+        const int32 FinalWidth = Results.GetFinalWidth(Index);
+        const int32 FinalHeight = Results.GetFinalHeight(Index);
+
+        // The existing LOD bias already keeps the top mips out of the pool
+        const int32 BiasedWidth = FMath::Max(1, Texture.Width >> Texture.LODBias);
+        const int32 BiasedHeight = FMath::Max(1, Texture.Height >> Texture.LODBias);
+        const TArray<int64> ResidentMips = Texture.LODBias > 0 ? GetOptimizedMipSizes(Texture, BiasedWidth, BiasedHeight) : Texture.MipSizes;
+        BeforeBytes[Index] = CalculateExpectedResidentBytes(ResidentMips, BiasedWidth, BiasedHeight, Texture, Settings);
+
+        if (Results.IsSuccess(Index) && FinalWidth > 0 && FinalHeight > 0)
+        {
+            const TArray<int64> OptimizedMips = GetOptimizedMipSizes(Texture, FinalWidth, FinalHeight);
+            AfterBytes[Index] = CalculateExpectedResidentBytes(OptimizedMips, FinalWidth, FinalHeight, Texture, Settings);
+        }
+        else
+        {
+            AfterBytes[Index] = BeforeBytes[Index];
+        }
+    });
+
+    const double BytesPerMB = 1024.0 * 1024.0;
+    for (int32 Index = 0; Index < Textures.Num(); Index++)
+    {
+        if (Textures[Index].bVirtualTexture)
+        {
+            Report.BeforeVirtualTextureResidentMB += (float)(BeforeBytes[Index] / BytesPerMB);
+            Report.AfterVirtualTextureResidentMB += (float)(AfterBytes[Index] / BytesPerMB);
+        }
+        else
+        {
+            Report.BeforeResidentMB += (float)(BeforeBytes[Index] / BytesPerMB);
+            Report.AfterResidentMB += (float)(AfterBytes[Index] / BytesPerMB);
+        }
+    }
+
+    return Report;
+}
@@ -0,0 +1,266 @@
+#include "BatchToolsStreamingTelemetry.h"
+#include "BatchToolsModule.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace BatchToolsTelemetry
+{
+    // Splits one CSV line; quoted fields are returned without their quotes
+    static void SplitLine(FStringView Line, TArray<FStringView>& OutFields)
+    {
+        OutFields.Reset();
+        int32 FieldStart = 0;
+        bool bInQuotes = false;
+
+        for (int32 Index = 0; Index <= Line.Len(); Index++)
+        {
+            if (Index < Line.Len() && Line[Index] == TEXT('"'))
+            {
+                bInQuotes = !bInQuotes;
+            }
+            else if (Index == Line.Len() || (Line[Index] == TEXT(',') && !bInQuotes))
+            {
+                FStringView Field = Line.Mid(FieldStart, Index - FieldStart).TrimStartAndEnd();
+                if (Field.Len() >= 2 && Field[0] == TEXT('"') && Field[Field.Len() - 1] == TEXT('"'))
+                    Field = Field.Mid(1, Field.Len() - 2);
+                OutFields.Add(Field);
+                FieldStart = Index + 1;
+            }
+        }
+    }
+
+    static bool IsNameHeader(FStringView Header)
+    {
+        static const TCHAR* NameHeaders[] = { TEXT("Name"), TEXT("TextureName"), TEXT("Texture"), TEXT("Path"), TEXT("ObjectPath"), TEXT("AssetPath") };
+        for (const TCHAR* NameHeader : NameHeaders)
+        {
+            if (Header.Equals(NameHeader, ESearchCase::IgnoreCase))
+                return true;
+        }
+        return false;
+    }
+
+    // Higher is better: an explicit requested size beats the resident size ListTextures reports
+    static int32 GetSizeHeaderPriority(FStringView Header)
+    {
+        if (Header.Contains(TEXT("Requested"), ESearchCase::IgnoreCase) || Header.Contains(TEXT("Wanted"), ESearchCase::IgnoreCase))
+            return 2;
+        if (Header.Contains(TEXT("Current"), ESearchCase::IgnoreCase) || Header.Contains(TEXT("InMem"), ESearchCase::IgnoreCase))
+            return 1;
+        return 0;
+    }
+
+    // Reads the first "W x H" in a field such as "1024x512" or "1024x512 (683 KB)"
+    static bool ParseSize(FStringView Field, int32& OutWidth, int32& OutHeight)
+    {
+        int32 Index = 0;
+        auto ReadNumber = [&Field, &Index](int32& OutValue)
+        {
+            while (Index < Field.Len() && Field[Index] == TEXT(' '))
+                Index++;
+            const int32 Start = Index;
+            int64 Value = 0;
+            while (Index < Field.Len() && FChar::IsDigit(Field[Index]) && Value < MAX_int32)
+                Value = Value * 10 + (Field[Index++] - TEXT('0'));
+            OutValue = (int32)FMath::Min<int64>(Value, MAX_int32);
+            return Index > Start;
+        };
+
+        if (!ReadNumber(OutWidth))
+            return false;
+        while (Index < Field.Len() && Field[Index] == TEXT(' '))
+            Index++;
+        if (Index >= Field.Len() || (Field[Index] != TEXT('x') && Field[Index] != TEXT('X')))
+            return false;
+        Index++;
+        return ReadNumber(OutHeight) && OutWidth > 0 && OutHeight > 0;
+    }
+
+    // "/Game/A/T_Wall.T_Wall", "Texture2D'/Game/A/T_Wall.T_Wall'" and "/Game/A/T_Wall" give the package
+    // name; anything without a path is kept as a bare asset name
+    static bool ParseTextureKey(FStringView Field, FName& OutKey)
+    {
+        int32 PathStart = INDEX_NONE;
+        if (!Field.FindChar(TEXT('/'), PathStart))
+        {
+            OutKey = Field.IsEmpty() ? NAME_None : FName(Field);
+            return false;
+        }
+
+        FStringView Path = Field.RightChop(PathStart);
+        int32 PathEnd = INDEX_NONE;
+        if (Path.FindChar(TEXT('.'), PathEnd) || Path.FindChar(TEXT('\''), PathEnd))
+            Path = Path.Left(PathEnd);
+        OutKey = FName(Path);
+        return true;
+    }
+}
+
+FBatchToolsTelemetrySettings FBatchToolsTelemetrySettings::Load()
+{
+    const TCHAR* Section = TEXT("BatchTools.Telemetry");
+    const FString& ConfigFilename = FBatchToolsModule::GetConfigFilename();
+
+    FBatchToolsTelemetrySettings Settings;
+    GConfig->GetInt(Section, TEXT("SafetyMarginMips"), Settings.SafetyMarginMips, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MinRuns"), Settings.MinRuns, ConfigFilename);
+    GConfig->GetInt(Section, TEXT("MaxLODBias"), Settings.MaxLODBias, ConfigFilename);
+
+    Settings.SafetyMarginMips = FMath::Max(0, Settings.SafetyMarginMips);
+    Settings.MinRuns = FMath::Max(1, Settings.MinRuns);
+    Settings.MaxLODBias = FMath::Clamp(Settings.MaxLODBias, 0, 13);
+    return Settings;
+}
+
+TArray<FString> FBatchToolsStreamingTelemetry::FindCaptureFiles(const TArray<FString>& FilesOrDirectories)
+{
+    TArray<FString> Filenames;
+    for (const FString& Input : FilesOrDirectories)
+    {
+        const FString Path = FPaths::ConvertRelativePathToFull(Input.TrimQuotes());
+        if (IFileManager::Get().DirectoryExists(*Path))
+        {
+            TArray<FString> Found;
+            IFileManager::Get().FindFilesRecursive(Found, *Path, TEXT("*.csv"), true, false);
+            Filenames.Append(Found);
+        }
+        else if (IFileManager::Get().FileExists(*Path))
+        {
+            Filenames.Add(Path);
+        }
+        else
+        {
+            UE_LOG(LogBatchTools, Warning, TEXT("Streaming capture %s not found"), *Path);
+        }
+    }
+    return Filenames;
+}
+
+void FBatchToolsStreamingTelemetry::ParseFile(const FString& Filename, FParsedFile& OutFile)
+{
+    int32 NameColumn = INDEX_NONE;
+    int32 SizeColumn = INDEX_NONE;
+    TArray<FStringView> Fields;
+
+    FFileHelper::LoadFileToStringWithLineVisitor(*Filename, [&](FStringView Line)
+    {
+        BatchToolsTelemetry::SplitLine(Line, Fields);
+
+        // Captures may start with console noise; the header is the first line naming both columns
+        if (!OutFile.bHasHeader)
+        {
+            int32 BestPriority = 0;
+            NameColumn = INDEX_NONE;
+            SizeColumn = INDEX_NONE;
+            for (int32 Column = 0; Column < Fields.Num(); Column++)
+            {
+                const int32 Priority = BatchToolsTelemetry::GetSizeHeaderPriority(Fields[Column]);
+                if (NameColumn == INDEX_NONE && BatchToolsTelemetry::IsNameHeader(Fields[Column]))
+                    NameColumn = Column;
+                else if (Priority > BestPriority)
+                {
+                    BestPriority = Priority;
+                    SizeColumn = Column;
+                }
+            }
+            OutFile.bHasHeader = NameColumn != INDEX_NONE && SizeColumn != INDEX_NONE;
+            return;
+        }
+
+        int32 Width = 0;
+        int32 Height = 0;
+        FName Key;
+        if (!Fields.IsValidIndex(NameColumn) || !Fields.IsValidIndex(SizeColumn) ||
+            !BatchToolsTelemetry::ParseSize(Fields[SizeColumn], Width, Height))
+            return;
+
+        const bool bIsPackage = BatchToolsTelemetry::ParseTextureKey(Fields[NameColumn], Key);
+        if (Key.IsNone())
+            return;
+
+        FStreamingTelemetryEntry& Entry = (bIsPackage ? OutFile.ByPackage : OutFile.ByName).FindOrAdd(Key);
+        Entry.MaxRequestedWidth = FMath::Max(Entry.MaxRequestedWidth, Width);
+        Entry.MaxRequestedHeight = FMath::Max(Entry.MaxRequestedHeight, Height);
+        Entry.NumRuns = 1;
+        OutFile.NumRows++;
+    });
+}
+
+void FBatchToolsStreamingTelemetry::MergeRun(const TMap<FName, FStreamingTelemetryEntry>& Run, TMap<FName, FStreamingTelemetryEntry>& Into)
+{
+    for (const TPair<FName, FStreamingTelemetryEntry>& Item : Run)
+    {
+        FStreamingTelemetryEntry& Entry = Into.FindOrAdd(Item.Key);
+        Entry.MaxRequestedWidth = FMath::Max(Entry.MaxRequestedWidth, Item.Value.MaxRequestedWidth);
+        Entry.MaxRequestedHeight = FMath::Max(Entry.MaxRequestedHeight, Item.Value.MaxRequestedHeight);
+        Entry.NumRuns += Item.Value.NumRuns;
+    }
+}
+
+void FBatchToolsStreamingTelemetry::IngestFiles(const TArray<FString>& Filenames)
+{
+    TArray<FParsedFile> Files;
+    Files.SetNum(Filenames.Num());
+
+    ParallelFor(Filenames.Num(), [&Filenames, &Files](int32 Index)
+    {
+        ParseFile(Filenames[Index], Files[Index]);
+    });
+
+    for (int32 Index = 0; Index < Files.Num(); Index++)
+    {
+        const FParsedFile& File = Files[Index];
+        if (!File.bHasHeader)
+        {
+            UE_LOG(LogBatchTools, Warning, TEXT("Skipping %s: no texture name and size columns found"), *Filenames[Index]);
+            continue;
+        }
+
+        MergeRun(File.ByPackage, EntriesByPackage);
+        MergeRun(File.ByName, EntriesByName);
+        NumRowsParsed += File.NumRows;
+        NumFiles++;
+    }
+
+    UE_LOG(LogBatchTools, Log, TEXT("Streaming telemetry: %d runs, %lld rows, %d textures"), NumFiles, NumRowsParsed, NumTextures());
+}
+
+TArray<const FStreamingTelemetryEntry*> FBatchToolsStreamingTelemetry::MatchAssets(const TArray<FAssetData>& Assets) const
+{
+    TMap<FName, int32> NameCounts;
+    if (EntriesByName.Num() > 0)
+    {
+        for (const FAssetData& Asset : Assets)
+            NameCounts.FindOrAdd(Asset.AssetName)++;
+    }
+
+    TArray<const FStreamingTelemetryEntry*> Matches;
+    Matches.Reserve(Assets.Num());
+    for (const FAssetData& Asset : Assets)
+    {
+        const FStreamingTelemetryEntry* Entry = EntriesByPackage.Find(Asset.PackageName);
+        if (!Entry && NameCounts.FindRef(Asset.AssetName) == 1)
+            Entry = EntriesByName.Find(Asset.AssetName);
+        Matches.Add(Entry);
+    }
+    return Matches;
+}
+
+int32 FBatchToolsStreamingTelemetry::CalculateLODBias(int32 Width, int32 Height, int32 CurrentLODBias, const FStreamingTelemetryEntry& Entry, const FBatchToolsTelemetrySettings& Settings)
+{
+    const int32 MaxDimension = FMath::Max(Width, Height);
+    const int32 MaxRequested = FMath::Max(Entry.MaxRequestedWidth, Entry.MaxRequestedHeight);
+    if (MaxDimension <= 0 || MaxRequested <= 0 || Entry.NumRuns < Settings.MinRuns)
+        return CurrentLODBias;
+
+    // Top mips larger than anything requested were never streamed in
+    int32 UnusedMips = 0;
+    while ((MaxDimension >> (UnusedMips + 1)) >= MaxRequested)
+        UnusedMips++;
+
+    const int32 LODBias = FMath::Clamp(UnusedMips - Settings.SafetyMarginMips, 0, Settings.MaxLODBias);
+    return FMath::Max(CurrentLODBias, LODBias);
+}
@@ -0,0 +1,421 @@
+#include "BatchToolsSubsystem.h"
+#include "BatchToolsTextureIndex.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Texture.h"
+#include "FileHelpers.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/Package.h"
+
+#define LOCTEXT_NAMESPACE "FBatchToolsModule"
+
+namespace BatchToolsSubsystem
+{
+    static EOptimizationMethod ToOptimizationMethod(EBatchToolsOptimizationMethod Method)
+    {
+        switch (Method)
+        {
+            case EBatchToolsOptimizationMethod::LODBias:
+                return EOptimizationMethod::LODBiasOnly;
+            case EBatchToolsOptimizationMethod::Reimport:
+                return EOptimizationMethod::ReimportOnly;
+            case EBatchToolsOptimizationMethod::MaxSize:
+                return EOptimizationMethod::MaxInGameSize;
+            default:
+                return EOptimizationMethod::SmartAuto;
+        }
+    }
+
+    static EBatchToolsOptimizationMethod FromOptimizationMethod(EOptimizationMethod Method)
+    {
+        switch (Method)
+        {
+            case EOptimizationMethod::LODBiasOnly:
+                return EBatchToolsOptimizationMethod::LODBias;
+            case EOptimizationMethod::ReimportOnly:
+                return EBatchToolsOptimizationMethod::Reimport;
+            case EOptimizationMethod::MaxInGameSize:
+                return EBatchToolsOptimizationMethod::MaxSize;
+            default:
+                return EBatchToolsOptimizationMethod::Smart;
+        }
+    }
+
+    static bool IsTextureAsset(const FAssetData& Asset)
+    {
+        return Asset.IsValid() && Asset.IsInstanceOf(UTexture::StaticClass());
+    }
+
+    static FBatchToolsTextureResult ToScriptResult(const FString& AssetPath, const FTextureOptimizationResult& Result)
+    {
+        FBatchToolsTextureResult ScriptResult;
+        ScriptResult.AssetPath = AssetPath;
+        ScriptResult.bSuccess = Result.bSuccess;
+        ScriptResult.Method = FromOptimizationMethod(Result.MethodUsed);
+        ScriptResult.OriginalWidth = Result.OriginalWidth;
+        ScriptResult.OriginalHeight = Result.OriginalHeight;
+        ScriptResult.FinalWidth = Result.FinalWidth;
+        ScriptResult.FinalHeight = Result.FinalHeight;
+        ScriptResult.VRAMSavedMB = Result.VRAMSavedMB;
+        ScriptResult.FileSizeSavedMB = Result.FileSizeSavedMB;
+        ScriptResult.ErrorMessage = Result.GetErrorMessage();
+        return ScriptResult;
+    }
+}
+
+void UBatchToolsSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+    Super::AddReferencedObjects(InThis, Collector);
+
+    UBatchToolsSubsystem* This = CastChecked<UBatchToolsSubsystem>(InThis);
+    for (TPair<int32, FApplyJob>& Pair : This->Jobs)
+    {
+        FTextureBatch& Batch = Pair.Value.Batch;
+        Collector.AddReferencedObjects(Batch.OptimizedTextures);
+        for (FPendingCookSize& Pending : Batch.PendingCookSizes)
+            Collector.AddReferencedObject(Pending.Texture);
+    }
+}
+
+void UBatchToolsSubsystem::Deinitialize()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+    Jobs.Reset();
+
+    Super::Deinitialize();
+}
+
+TArray<FString> UBatchToolsSubsystem::FindTextures(const TArray<FString>& Folders)
+{
+    FBatchToolsModule& BatchTools = FModuleManager::LoadModuleChecked<FBatchToolsModule>("BatchTools");
+
+    TArray<FString> AssetPaths;
+    for (const FAssetData& Asset : BatchTools.GetTexturesFromPaths(Folders))
+    {
+        AssetPaths.Add(Asset.GetObjectPathString());
+    }
+    return AssetPaths;
+}
+
+TArray<FAssetData> UBatchToolsSubsystem::ResolveAssetPaths(const TArray<FString>& AssetPaths) const
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    // One entry per path; invalid FAssetData where the path is not a texture
+    TArray<FAssetData> Assets;
+    Assets.SetNum(AssetPaths.Num());
+
+    for (int32 Index = 0; Index < AssetPaths.Num(); Index++)
+    {
+        const FString& AssetPath = AssetPaths[Index];
+        FAssetData Asset;
+
+        if (AssetPath.Contains(TEXT(".")))
+        {
+            Asset = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(AssetPath));
+        }
+        else
+        {
+            TArray<FAssetData> PackageAssets;
+            AssetRegistry.GetAssetsByPackageName(FName(*AssetPath), PackageAssets);
+            for (const FAssetData& PackageAsset : PackageAssets)
+            {
+                if (BatchToolsSubsystem::IsTextureAsset(PackageAsset))
+                {
+                    Asset = PackageAsset;
+                    break;
+                }
+            }
+        }
+
+        if (BatchToolsSubsystem::IsTextureAsset(Asset))
+            Assets[Index] = MoveTemp(Asset);
+    }
+
+    return Assets;
+}
+
+TArray<FBatchToolsTextureAnalysis> UBatchToolsSubsystem::AnalyzeTextures(const TArray<FString>& AssetPaths)
+{
+    const TArray<FAssetData> Assets = ResolveAssetPaths(AssetPaths);
+    const TArray<FTexturePolicyDecision> Decisions = FBatchToolsPolicy::Get().EvaluateBatch(Assets);
+
+    TArray<FBatchToolsTextureAnalysis> Analyses;
+    Analyses.SetNum(Assets.Num());
+
+    for (int32 Index = 0; Index < Assets.Num(); Index++)
+    {
+        FBatchToolsTextureAnalysis& Analysis = Analyses[Index];
+        Analysis.AssetPath = AssetPaths[Index];
+        if (!Assets[Index].IsValid())
+            continue;
+
+        const FTextureIndexEntry Entry = FBatchToolsTextureIndex::ReadAssetTags(Assets[Index]);
+        Analysis.bFound = true;
+        Analysis.Width = Entry.Width;
+        Analysis.Height = Entry.Height;
+        Analysis.Format = Entry.Format;
+        Analysis.LODGroup = Entry.LODGroup;
+        Analysis.LODBias = Entry.LODBias;
+        Analysis.bHasSourceFile = Entry.bHasSource;
+        Analysis.ResidentMB = (float)((double)Entry.ResidentBytes / (1024.0 * 1024.0));
+        Analysis.bSkippedByPolicy = Decisions[Index].bSkip;
+        Analysis.PolicyMaxSize = Decisions[Index].MaxSize;
+    }
+
+    return Analyses;
+}
+
+TArray<FBatchToolsTexturePlan> UBatchToolsSubsystem::PlanTextures(const TArray<FString>& AssetPaths, EBatchToolsOptimizationMethod Method, int32 TargetResolution)
+{
+    FBatchToolsModule& BatchTools = FModuleManager::LoadModuleChecked<FBatchToolsModule>("BatchTools");
+
+    const TArray<FAssetData> Assets = ResolveAssetPaths(AssetPaths);
+    const TArray<FTexturePolicyDecision> Decisions = FBatchToolsPolicy::Get().EvaluateBatch(Assets);
+    const EOptimizationMethod RequestedMethod = BatchToolsSubsystem::ToOptimizationMethod(Method);
+
+    TArray<FBatchToolsTexturePlan> Plans;
+    Plans.SetNum(Assets.Num());
+
+    for (int32 Index = 0; Index < Assets.Num(); Index++)
+    {
+        FBatchToolsTexturePlan& Plan = Plans[Index];
+        Plan.AssetPath = AssetPaths[Index];
+        Plan.Method = Method;
+
+        if (!Assets[Index].IsValid())
+        {
+            Plan.Reason = TEXT("Not a texture");
+            continue;
+        }
+
+        const FTexturePolicyDecision& Decision = Decisions[Index];
+        if (Decision.bSkip)
+        {
+            Plan.Reason = FormatOptimizationError(EOptimizationError::SkippedByPolicy);
+            continue;
+        }
+
+        const FTextureIndexEntry Entry = FBatchToolsTextureIndex::ReadAssetTags(Assets[Index]);
+        Plan.TargetResolution = Decision.ClampTarget(TargetResolution);
+
+        const FTextureOptimizationResult Result = BatchTools.PlanTexture(Assets[Index].AssetName, Entry.Width, Entry.Height, 
+                                                                         Entry.bHasSource, Decision.Method.Get(RequestedMethod), Plan.TargetResolution);
+        Plan.bWillChange = Result.bSuccess;
+        Plan.Method = BatchToolsSubsystem::FromOptimizationMethod(Result.MethodUsed);
+        Plan.PlannedWidth = Result.FinalWidth;
+        Plan.PlannedHeight = Result.FinalHeight;
+        Plan.VRAMSavedMB = Result.VRAMSavedMB;
+        Plan.Reason = Result.GetErrorMessage();
+    }
+
+    return Plans;
+}
+
+void UBatchToolsSubsystem::InitJob(FApplyJob& Job, const TArray<FString>& AssetPaths, EBatchToolsOptimizationMethod Method, int32 TargetResolution, bool bSave) const
+{
+    Job.AssetPaths = AssetPaths;
+    Job.Assets = ResolveAssetPaths(AssetPaths);
+    Job.Decisions = FBatchToolsPolicy::Get().EvaluateBatch(Job.Assets);
+    Job.Method = BatchToolsSubsystem::ToOptimizationMethod(Method);
+    Job.TargetResolution = FMath::Max(1, TargetResolution);
+    Job.bSave = bSave;
+    Job.Results.Reserve(AssetPaths.Num());
+    Job.BatchRows.Reserve(AssetPaths.Num());
+}
+
+void UBatchToolsSubsystem::ApplyNext(FApplyJob& Job)
+{
+    const int32 Index = Job.NextIndex++;
+    const FAssetData& Asset = Job.Assets[Index];
+
+    FBatchToolsTextureResult& ScriptResult = Job.Results.AddDefaulted_GetRef();
+    ScriptResult.AssetPath = Job.AssetPaths[Index];
+    Job.BatchRows.Add(INDEX_NONE);
+
+    if (!Asset.IsValid())
+    {
+        ScriptResult.ErrorMessage = FormatOptimizationError(EOptimizationError::NotATexture);
+        return;
+    }
+
+    if (Job.Decisions[Index].bSkip)
+    {
+        ScriptResult.ErrorMessage = FormatOptimizationError(EOptimizationError::SkippedByPolicy);
+        return;
+    }
+
+    UTexture* Texture = Cast<UTexture>(Asset.GetAsset());
+    if (!Texture)
+    {
+        ScriptResult.ErrorMessage = FormatOptimizationError(EOptimizationError::LoadFailed);
+        return;
+    }
+
+    // Max in-game size builds are deferred to FinishJob, so a slice stays within its time budget
+    FBatchToolsModule& BatchTools = FModuleManager::LoadModuleChecked<FBatchToolsModule>("BatchTools");
+    const int32 Row = BatchTools.AddToTextureBatch(Job.Batch, Texture, Job.Decisions[Index], Job.Method, Job.TargetResolution);
+    ScriptResult = BatchToolsSubsystem::ToScriptResult(Job.AssetPaths[Index], Job.Batch.Results.GetRow(Row));
+    Job.BatchRows[Index] = Row;
+}
+
+void UBatchToolsSubsystem::FinishJob(FApplyJob& Job)
+{
+    FBatchToolsModule& BatchTools = FModuleManager::LoadModuleChecked<FBatchToolsModule>("BatchTools");
+    FStreamingSimulationReport StreamingReport;
+    BatchTools.FinishTextureBatch(Job.Batch, &StreamingReport);
+
+    // Cooked sizes are only known once the batch is built
+    for (int32 Index = 0; Index < Job.BatchRows.Num(); Index++)
+    {
+        if (Job.BatchRows[Index] != INDEX_NONE)
+            Job.Results[Index] = BatchToolsSubsystem::ToScriptResult(Job.AssetPaths[Index], Job.Batch.Results.GetRow(Job.BatchRows[Index]));
+    }
+
+    TSet<UPackage*> DirtyPackageSet;
+    for (UTexture* Texture : Job.Batch.OptimizedTextures)
+    {
+        if (Texture && Texture->GetPackage()->IsDirty())
+            DirtyPackageSet.Add(Texture->GetPackage());
+    }
+    TArray<UPackage*> DirtyPackages = DirtyPackageSet.Array();
+
+    if (Job.bSave && DirtyPackages.Num() > 0 && !UEditorLoadingAndSavingUtils::SavePackages(DirtyPackages, false))
+    {
+        UE_LOG(LogBatchTools, Error, TEXT("Failed to save %d modified packages"), DirtyPackages.Num());
+    }
+
+    if (StreamingReport.NumTextures > 0)
+    {
+        UE_LOG(LogBatchTools, Log, TEXT("Simulated streaming pool residency: %.1fMB -> %.1fMB of %.0fMB (overcommit %.1fMB -> %.1fMB), VT pool: %.1fMB -> %.1fMB of %.0fMB"), 
+               StreamingReport.BeforeResidentMB, StreamingReport.AfterResidentMB, StreamingReport.PoolSizeMB,
+               StreamingReport.GetBeforeOvercommitMB(), StreamingReport.GetAfterOvercommitMB(),
+               StreamingReport.BeforeVirtualTextureResidentMB, StreamingReport.AfterVirtualTextureResidentMB, StreamingReport.VirtualTexturePoolSizeMB);
+    }
+
+    Job.Batch = FTextureBatch();
+    Job.BatchRows.Reset();
+    Job.Assets.Reset();
+    Job.Decisions.Reset();
+}
+
+TArray<FBatchToolsTextureResult> UBatchToolsSubsystem::ApplyTextures(const TArray<FString>& AssetPaths, EBatchToolsOptimizationMethod Method, int32 TargetResolution, bool bSave)
+{
+    FApplyJob Job;
+    InitJob(Job, AssetPaths, Method, TargetResolution, bSave);
+
+    FScopedSlowTask SlowTask(AssetPaths.Num(), LOCTEXT("OptimizingTextures", "Optimizing Textures..."));
+    SlowTask.MakeDialog();
+
+    while (Job.NextIndex < Job.Assets.Num())
+    {
+        SlowTask.EnterProgressFrame(1);
+        ApplyNext(Job);
+    }
+    FinishJob(Job);
+
+    return MoveTemp(Job.Results);
+}
+
+FBatchToolsJobHandle UBatchToolsSubsystem::ApplyTexturesAsync(const TArray<FString>& AssetPaths, EBatchToolsOptimizationMethod Method, int32 TargetResolution, bool bSave, float TimeBudgetMs)
+{
+    FBatchToolsJobHandle Handle;
+    Handle.Id = NextJobId++;
+
+    FApplyJob& Job = Jobs.Add(Handle.Id);
+    InitJob(Job, AssetPaths, Method, TargetResolution, bSave);
+    Job.TimeBudgetSeconds = FMath::Max(0.001, (double)TimeBudgetMs / 1000.0);
+
+    // Texture edits have to stay on the game thread, so jobs advance a slice per tick
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UBatchToolsSubsystem::Tick));
+    }
+
+    return Handle;
+}
+
+bool UBatchToolsSubsystem::Tick(float DeltaTime)
+{
+    // Oldest running job first
+    FApplyJob* ActiveJob = nullptr;
+    int32 ActiveJobId = INDEX_NONE;
+    for (TPair<int32, FApplyJob>& Pair : Jobs)
+    {
+        if (Pair.Value.State == EBatchToolsJobState::Running && (ActiveJobId == INDEX_NONE || Pair.Key < ActiveJobId))
+        {
+            ActiveJob = &Pair.Value;
+            ActiveJobId = Pair.Key;
+        }
+    }
+
+    if (!ActiveJob)
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    while (ActiveJob->NextIndex < ActiveJob->Assets.Num() && FPlatformTime::Seconds() - StartTime < ActiveJob->TimeBudgetSeconds)
+    {
+        ApplyNext(*ActiveJob);
+    }
+
+    if (ActiveJob->NextIndex >= ActiveJob->Assets.Num())
+    {
+        FinishJob(*ActiveJob);
+        ActiveJob->State = EBatchToolsJobState::Completed;
+
+        FBatchToolsJobHandle Handle;
+        Handle.Id = ActiveJobId;
+        OnJobCompleted.Broadcast(Handle);
+    }
+
+    return true;
+}
+
+EBatchToolsJobState UBatchToolsSubsystem::GetJobState(FBatchToolsJobHandle Job) const
+{
+    const FApplyJob* FoundJob = Jobs.Find(Job.Id);
+    return FoundJob ? FoundJob->State : EBatchToolsJobState::Invalid;
+}
+
+float UBatchToolsSubsystem::GetJobProgress(FBatchToolsJobHandle Job) const
+{
+    const FApplyJob* FoundJob = Jobs.Find(Job.Id);
+    if (!FoundJob)
+        return 0.0f;
+
+    if (FoundJob->State == EBatchToolsJobState::Completed || FoundJob->AssetPaths.Num() == 0)
+        return 1.0f;
+
+    return (float)FoundJob->Results.Num() / (float)FoundJob->AssetPaths.Num();
+}
+
+TArray<FBatchToolsTextureResult> UBatchToolsSubsystem::GetJobResults(FBatchToolsJobHandle Job) const
+{
+    const FApplyJob* FoundJob = Jobs.Find(Job.Id);
+    return FoundJob ? FoundJob->Results : TArray<FBatchToolsTextureResult>();
+}
+
+void UBatchToolsSubsystem::CancelJob(FBatchToolsJobHandle Job)
+{
+    FApplyJob* FoundJob = Jobs.Find(Job.Id);
+    if (FoundJob && FoundJob->State == EBatchToolsJobState::Running)
+    {
+        // Textures already processed keep their changes
+        FinishJob(*FoundJob);
+        FoundJob->State = EBatchToolsJobState::Cancelled;
+    }
+}
+
+void UBatchToolsSubsystem::ReleaseJob(FBatchToolsJobHandle Job)
+{
+    const FApplyJob* FoundJob = Jobs.Find(Job.Id);
+    if (FoundJob && FoundJob->State != EBatchToolsJobState::Running)
+    {
+        Jobs.Remove(Job.Id);
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,629 @@
+#include "BatchToolsTextureIndex.h"
+#include "BatchToolsModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "EditorFramework/AssetImportData.h"
+#include "Engine/Texture2D.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "PixelFormat.h"
+
+namespace BatchToolsTextureIndex
+{
+    static const uint32 SnapshotMagic = 0x58495442; // 'BTIX'
+    static const int32 SnapshotVersion = 1;
+    // Registry events arrive in bursts during imports and saves; the snapshot is rewritten at most this often
+    static const double SnapshotSaveInterval = 10.0;
+
+    static const FName DimensionsTag(TEXT("Dimensions"));
+    static const FName FormatTag(TEXT("Format"));
+    static const FName LODGroupTag(TEXT("LODGroup"));
+    static const FName LODBiasTag(TEXT("LODBias"));
+
+    static const TMap<FName, EPixelFormat>& GetPixelFormatsByName()
+    {
+        static const TMap<FName, EPixelFormat> FormatsByName = []()
+        {
+            TMap<FName, EPixelFormat> Map;
+            for (int32 FormatIndex = 0; FormatIndex < PF_MAX; FormatIndex++)
+            {
+                if (GPixelFormats[FormatIndex].Name)
+                    Map.Add(FName(GPixelFormats[FormatIndex].Name), (EPixelFormat)FormatIndex);
+            }
+            return Map;
+        }();
+        return FormatsByName;
+    }
+
+    static IAssetRegistry& GetAssetRegistry()
+    {
+        return FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    }
+
+    // Name columns are stored as indices into a string table
+    static void SerializeNameColumn(FArchive& Ar, TArray<FName>& Column, TArray<FString>& StringTable, TMap<FName, int32>& StringIds)
+    {
+        TArray<int32> Ids;
+        if (Ar.IsSaving())
+        {
+            Ids.Reserve(Column.Num());
+            for (FName Name : Column)
+            {
+                int32* Id = StringIds.Find(Name);
+                if (!Id)
+                {
+                    Id = &StringIds.Add(Name, StringTable.Add(Name.ToString()));
+                }
+                Ids.Add(*Id);
+            }
+            Ar << Ids;
+        }
+        else
+        {
+            Ar << Ids;
+            Column.Reset(Ids.Num());
+            for (int32 Id : Ids)
+                Column.Add(StringTable.IsValidIndex(Id) ? FName(*StringTable[Id]) : NAME_None);
+        }
+    }
+}
+
+FBatchToolsTextureIndex::FBatchToolsTextureIndex()
+{
+    // Built here so worker threads only ever read it
+    BatchToolsTextureIndex::GetPixelFormatsByName();
+}
+
+FBatchToolsTextureIndex::~FBatchToolsTextureIndex()
+{
+    StopListening();
+    if (bSnapshotDirty)
+        Save();
+}
+
+FString FBatchToolsTextureIndex::GetSnapshotFilename()
+{
+    return FPaths::ProjectSavedDir() / TEXT("BatchTools") / TEXT("TextureIndex.btidx");
+}
+
+int64 FBatchToolsTextureIndex::EstimateResidentBytes(int32 Width, int32 Height, FName Format, int32 LODBias)
+{
+    int64 TotalBytes = 0;
+    for (int64 MipBytes : EstimateMipSizes(Width >> FMath::Max(0, LODBias), Height >> FMath::Max(0, LODBias), Format))
+        TotalBytes += MipBytes;
+    return TotalBytes;
+}
+
+TArray<int64> FBatchToolsTextureIndex::EstimateMipSizes(int32 Width, int32 Height, FName Format)
+{
+    int32 BlockSizeX = 1;
+    int32 BlockSizeY = 1;
+    int32 BlockBytes = 1;
+
+    if (const EPixelFormat* PixelFormat = BatchToolsTextureIndex::GetPixelFormatsByName().Find(Format))
+    {
+        const FPixelFormatInfo& FormatInfo = GPixelFormats[*PixelFormat];
+        BlockSizeX = FMath::Max(1, FormatInfo.BlockSizeX);
+        BlockSizeY = FMath::Max(1, FormatInfo.BlockSizeY);
+        BlockBytes = FMath::Max(1, FormatInfo.BlockBytes);
+    }
+
+    TArray<int64> MipSizes;
+    int32 MipWidth = FMath::Max(1, Width);
+    int32 MipHeight = FMath::Max(1, Height);
+
+    while (true)
+    {
+        MipSizes.Add((int64)FMath::DivideAndRoundUp(MipWidth, BlockSizeX) * FMath::DivideAndRoundUp(MipHeight, BlockSizeY) * BlockBytes);
+        if (MipWidth == 1 && MipHeight == 1)
+            break;
+        MipWidth = FMath::Max(1, MipWidth / 2);
+        MipHeight = FMath::Max(1, MipHeight / 2);
+    }
+
+    return MipSizes;
+}
+
+int32 FBatchToolsTextureIndex::FindRow(FName PackageName) const
+{
+    const int32* Row = RowByPackage.Find(PackageName);
+    return Row ? *Row : INDEX_NONE;
+}
+
+void FBatchToolsTextureIndex::Build(const FString& RootPath)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    IndexedRootPath = RootPath;
+    ResetColumns();
+
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+    Filter.PackagePaths.Add(FName(*RootPath));
+    Filter.bRecursivePaths = true;
+
+    TArray<FAssetData> Assets;
+    BatchToolsTextureIndex::GetAssetRegistry().GetAssets(Filter, Assets);
+
+    UpdateRows(Assets);
+    if (bListening)
+        bSnapshotDirty = true;
+    else
+        Save();
+
+    UE_LOG(LogBatchTools, Log, TEXT("Texture index built: %d textures under %s in %.2fs"), Num(), *RootPath, FPlatformTime::Seconds() - StartTime);
+    ChangedDelegate.Broadcast();
+}
+
+void FBatchToolsTextureIndex::ResetColumns()
+{
+    PackageNames.Reset();
+    AssetNames.Reset();
+    Folders.Reset();
+    Formats.Reset();
+    LODGroups.Reset();
+    Widths.Reset();
+    Heights.Reset();
+    ResidentBytes.Reset();
+    LODBiases.Reset();
+    HasSource.Reset();
+    ReferencerCounts.Reset();
+    RowByPackage.Reset();
+    DirtyPackages.Reset();
+    RemovedPackages.Reset();
+}
+
+void FBatchToolsTextureIndex::Refresh()
+{
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+    Filter.PackagePaths.Add(FName(*IndexedRootPath));
+    Filter.bRecursivePaths = true;
+
+    TArray<FAssetData> Assets;
+    BatchToolsTextureIndex::GetAssetRegistry().GetAssets(Filter, Assets);
+
+    TSet<FName> PresentPackages;
+    PresentPackages.Reserve(Assets.Num());
+
+    TArray<FAssetData> ChangedAssets;
+    for (const FAssetData& Asset : Assets)
+    {
+        PresentPackages.Add(Asset.PackageName);
+        if (!RowByPackage.Contains(Asset.PackageName) || DirtyPackages.Contains(Asset.PackageName))
+            ChangedAssets.Add(Asset);
+    }
+
+    TArray<FName> StalePackages;
+    for (const TPair<FName, int32>& Pair : RowByPackage)
+    {
+        if (!PresentPackages.Contains(Pair.Key))
+            StalePackages.Add(Pair.Key);
+    }
+
+    for (FName PackageName : StalePackages)
+        RemoveRow(PackageName);
+
+    UpdateRows(ChangedAssets);
+    DirtyPackages.Reset();
+    RemovedPackages.Reset();
+
+    if (ChangedAssets.Num() > 0 || StalePackages.Num() > 0)
+    {
+        // Written by the next tick once listening starts
+        if (!bListening)
+            Save();
+        ChangedDelegate.Broadcast();
+    }
+
+    UE_LOG(LogBatchTools, Log, TEXT("Texture index refreshed: %d updated, %d removed"), ChangedAssets.Num(), StalePackages.Num());
+}
+
+void FBatchToolsTextureIndex::UpdateRows(const TArray<FAssetData>& Assets)
+{
+    TArray<int32> Rows;
+    Rows.Reserve(Assets.Num());
+
+    // Allocate rows serially, fill them in parallel
+    for (const FAssetData& Asset : Assets)
+    {
+        int32 Row = FindRow(Asset.PackageName);
+        if (Row == INDEX_NONE)
+        {
+            Row = PackageNames.AddDefaulted();
+            AssetNames.AddDefaulted();
+            Folders.AddDefaulted();
+            Formats.AddDefaulted();
+            LODGroups.AddDefaulted();
+            Widths.AddDefaulted();
+            Heights.AddDefaulted();
+            ResidentBytes.AddDefaulted();
+            LODBiases.AddDefaulted();
+            HasSource.AddDefaulted();
+            ReferencerCounts.AddDefaulted();
+            RowByPackage.Add(Asset.PackageName, Row);
+        }
+        Rows.Add(Row);
+    }
+
+    // Resolved here, the module manager must not be touched from worker threads
+    const IAssetRegistry& AssetRegistry = BatchToolsTextureIndex::GetAssetRegistry();
+    ParallelFor(Assets.Num(), [this, &Assets, &Rows, &AssetRegistry](int32 Index)
+    {
+        ComputeRow(Rows[Index], Assets[Index], AssetRegistry);
+    });
+
+    if (Assets.Num() > 0)
+        bSnapshotDirty = true;
+}
+
+FTextureIndexEntry FBatchToolsTextureIndex::ReadAssetTags(const FAssetData& Asset)
+{
+    FTextureIndexEntry Entry;
+
+    FString Dimensions;
+    if (Asset.GetTagValue(BatchToolsTextureIndex::DimensionsTag, Dimensions))
+    {
+        FString WidthString;
+        FString HeightString;
+        if (Dimensions.Split(TEXT("x"), &WidthString, &HeightString))
+        {
+            Entry.Width = FCString::Atoi(*WidthString);
+            Entry.Height = FCString::Atoi(*HeightString);
+        }
+    }
+
+    Asset.GetTagValue(BatchToolsTextureIndex::FormatTag, Entry.Format);
+    Asset.GetTagValue(BatchToolsTextureIndex::LODGroupTag, Entry.LODGroup);
+
+    Asset.GetTagValue(BatchToolsTextureIndex::LODBiasTag, Entry.LODBias);
+    Entry.LODBias = FMath::Clamp(Entry.LODBias, 0, 15);
+
+    Entry.ResidentBytes = EstimateResidentBytes(Entry.Width, Entry.Height, Entry.Format, Entry.LODBias);
+
+    // Same check as DoesSourceFileExist, resolved from the import data tag instead of the loaded object
+    FString ImportDataJson;
+    if (Asset.GetTagValue(UObject::SourceFileTagName(), ImportDataJson))
+    {
+        TOptional<FAssetImportInfo> ImportInfo = FAssetImportInfo::FromJson(ImportDataJson);
+        if (ImportInfo.IsSet() && ImportInfo->SourceFiles.Num() > 0)
+        {
+            TStringBuilder<256> PackageName;
+            Asset.PackageName.ToString(PackageName);
+            const FString SourceFilePath = UAssetImportData::ResolveImportFilename(ImportInfo->SourceFiles[0].RelativeFilename, PackageName.ToView());
+            Entry.bHasSource = !SourceFilePath.IsEmpty() && FPaths::FileExists(SourceFilePath);
+        }
+    }
+
+    return Entry;
+}
+
+void FBatchToolsTextureIndex::ComputeRow(int32 Row, const FAssetData& Asset, const IAssetRegistry& AssetRegistry)
+{
+    PackageNames[Row] = Asset.PackageName;
+    AssetNames[Row] = Asset.AssetName;
+    Folders[Row] = Asset.PackagePath;
+
+    const FTextureIndexEntry Entry = ReadAssetTags(Asset);
+    Widths[Row] = (uint16)FMath::Clamp(Entry.Width, 0, (int32)MAX_uint16);
+    Heights[Row] = (uint16)FMath::Clamp(Entry.Height, 0, (int32)MAX_uint16);
+    Formats[Row] = Entry.Format;
+    LODGroups[Row] = Entry.LODGroup;
+    LODBiases[Row] = (uint8)Entry.LODBias;
+    ResidentBytes[Row] = Entry.ResidentBytes;
+    HasSource[Row] = Entry.bHasSource ? 1 : 0;
+
+    TArray<FName> Referencers;
+    AssetRegistry.GetReferencers(Asset.PackageName, Referencers);
+    ReferencerCounts[Row] = Referencers.Num();
+}
+
+void FBatchToolsTextureIndex::RemoveRow(FName PackageName)
+{
+    int32 Row = INDEX_NONE;
+    if (!RowByPackage.RemoveAndCopyValue(PackageName, Row))
+        return;
+
+    PackageNames.RemoveAtSwap(Row);
+    AssetNames.RemoveAtSwap(Row);
+    Folders.RemoveAtSwap(Row);
+    Formats.RemoveAtSwap(Row);
+    LODGroups.RemoveAtSwap(Row);
+    Widths.RemoveAtSwap(Row);
+    Heights.RemoveAtSwap(Row);
+    ResidentBytes.RemoveAtSwap(Row);
+    LODBiases.RemoveAtSwap(Row);
+    HasSource.RemoveAtSwap(Row);
+    ReferencerCounts.RemoveAtSwap(Row);
+
+    // The last row moved into the hole
+    if (Row < PackageNames.Num())
+        RowByPackage.Add(PackageNames[Row], Row);
+
+    bSnapshotDirty = true;
+}
+
+bool FBatchToolsTextureIndex::Save()
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Ar(Bytes);
+
+    uint32 Magic = BatchToolsTextureIndex::SnapshotMagic;
+    int32 Version = BatchToolsTextureIndex::SnapshotVersion;
+    FString RootPath = IndexedRootPath;
+    Ar << Magic << Version << RootPath;
+
+    // Write name columns first so the string table is complete, then prepend it
+    TArray<FString> StringTable;
+    TMap<FName, int32> StringIds;
+    TArray<uint8> ColumnBytes;
+    FMemoryWriter ColumnAr(ColumnBytes);
+
+    BatchToolsTextureIndex::SerializeNameColumn(ColumnAr, PackageNames, StringTable, StringIds);
+    BatchToolsTextureIndex::SerializeNameColumn(ColumnAr, AssetNames, StringTable, StringIds);
+    BatchToolsTextureIndex::SerializeNameColumn(ColumnAr, Folders, StringTable, StringIds);
+    BatchToolsTextureIndex::SerializeNameColumn(ColumnAr, Formats, StringTable, StringIds);
+    BatchToolsTextureIndex::SerializeNameColumn(ColumnAr, LODGroups, StringTable, StringIds);
+    ColumnAr << Widths << Heights << ResidentBytes << LODBiases << HasSource << ReferencerCounts;
+
+    Ar << StringTable;
+    Ar.Serialize(ColumnBytes.GetData(), ColumnBytes.Num());
+
+    const bool bSaved = FFileHelper::SaveArrayToFile(Bytes, *GetSnapshotFilename());
+    LastSaveTime = FPlatformTime::Seconds();
+    if (bSaved)
+        bSnapshotDirty = false;
+    else
+        UE_LOG(LogBatchTools, Warning, TEXT("Could not write texture index to %s"), *GetSnapshotFilename());
+
+    return bSaved;
+}
+
+bool FBatchToolsTextureIndex::Load()
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *GetSnapshotFilename(), FILEREAD_Silent))
+        return false;
+
+    FMemoryReader Ar(Bytes);
+
+    uint32 Magic = 0;
+    int32 Version = 0;
+    FString RootPath;
+    Ar << Magic << Version;
+    if (Magic != BatchToolsTextureIndex::SnapshotMagic || Version != BatchToolsTextureIndex::SnapshotVersion)
+    {
+        UE_LOG(LogBatchTools, Log, TEXT("Ignoring texture index with unknown version, it will be rebuilt"));
+        return false;
+    }
+    Ar << RootPath;
+
+    TArray<FString> StringTable;
+    TMap<FName, int32> StringIds;
+    Ar << StringTable;
+
+    BatchToolsTextureIndex::SerializeNameColumn(Ar, PackageNames, StringTable, StringIds);
+    BatchToolsTextureIndex::SerializeNameColumn(Ar, AssetNames, StringTable, StringIds);
+    BatchToolsTextureIndex::SerializeNameColumn(Ar, Folders, StringTable, StringIds);
+    BatchToolsTextureIndex::SerializeNameColumn(Ar, Formats, StringTable, StringIds);
+    BatchToolsTextureIndex::SerializeNameColumn(Ar, LODGroups, StringTable, StringIds);
+    Ar << Widths << Heights << ResidentBytes << LODBiases << HasSource << ReferencerCounts;
+
+    const int32 NumRows = PackageNames.Num();
+    if (Ar.IsError() || AssetNames.Num() != NumRows || Widths.Num() != NumRows || ReferencerCounts.Num() != NumRows)
+    {
+        UE_LOG(LogBatchTools, Warning, TEXT("Texture index %s is corrupt, it will be rebuilt"), *GetSnapshotFilename());
+        ResetColumns();
+        return false;
+    }
+
+    IndexedRootPath = RootPath;
+    RowByPackage.Reset();
+    RowByPackage.Reserve(NumRows);
+    for (int32 Row = 0; Row < NumRows; Row++)
+        RowByPackage.Add(PackageNames[Row], Row);
+
+    bSnapshotDirty = false;
+    ChangedDelegate.Broadcast();
+    return true;
+}
+
+void FBatchToolsTextureIndex::StartListening()
+{
+    if (bListening)
+        return;
+
+    IAssetRegistry& AssetRegistry = BatchToolsTextureIndex::GetAssetRegistry();
+    AssetRegistry.OnAssetAdded().AddRaw(this, &FBatchToolsTextureIndex::OnAssetAdded);
+    AssetRegistry.OnAssetRemoved().AddRaw(this, &FBatchToolsTextureIndex::OnAssetRemoved);
+    AssetRegistry.OnAssetRenamed().AddRaw(this, &FBatchToolsTextureIndex::OnAssetRenamed);
+    AssetRegistry.OnAssetUpdated().AddRaw(this, &FBatchToolsTextureIndex::OnAssetUpdated);
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBatchToolsTextureIndex::Tick), 1.0f);
+    bListening = true;
+}
+
+void FBatchToolsTextureIndex::StopListening()
+{
+    if (!bListening)
+        return;
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
+    {
+        IAssetRegistry& AssetRegistry = BatchToolsTextureIndex::GetAssetRegistry();
+        AssetRegistry.OnAssetAdded().RemoveAll(this);
+        AssetRegistry.OnAssetRemoved().RemoveAll(this);
+        AssetRegistry.OnAssetRenamed().RemoveAll(this);
+        AssetRegistry.OnAssetUpdated().RemoveAll(this);
+    }
+
+    bListening = false;
+}
+
+bool FBatchToolsTextureIndex::IsIndexedTexture(const FAssetData& Asset) const
+{
+    TStringBuilder<256> PackagePath;
+    Asset.PackagePath.ToString(PackagePath);
+
+    // The root itself or a folder below it, /GameX is not under /Game
+    const FStringView PathView = PackagePath.ToView();
+    const bool bUnderRoot = PathView.StartsWith(IndexedRootPath) 
+        && (PathView.Len() == IndexedRootPath.Len() || PathView[IndexedRootPath.Len()] == TEXT('/'));
+    return bUnderRoot && Asset.IsInstanceOf(UTexture2D::StaticClass());
+}
+
+void FBatchToolsTextureIndex::OnAssetAdded(const FAssetData& Asset)
+{
+    if (IsIndexedTexture(Asset))
+    {
+        RemovedPackages.Remove(Asset.PackageName);
+        DirtyPackages.Add(Asset.PackageName);
+    }
+}
+
+void FBatchToolsTextureIndex::OnAssetRemoved(const FAssetData& Asset)
+{
+    if (RowByPackage.Contains(Asset.PackageName))
+    {
+        DirtyPackages.Remove(Asset.PackageName);
+        RemovedPackages.Add(Asset.PackageName);
+    }
+}
+
+void FBatchToolsTextureIndex::OnAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath)
+{
+    const FName OldPackageName(*FPackageName::ObjectPathToPackageName(OldObjectPath));
+    if (RowByPackage.Contains(OldPackageName))
+        RemovedPackages.Add(OldPackageName);
+
+    OnAssetAdded(Asset);
+}
+
+void FBatchToolsTextureIndex::OnAssetUpdated(const FAssetData& Asset)
+{
+    if (IsIndexedTexture(Asset))
+        DirtyPackages.Add(Asset.PackageName);
+}
+
+bool FBatchToolsTextureIndex::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (bSnapshotDirty && Now - LastSaveTime >= BatchToolsTextureIndex::SnapshotSaveInterval)
+        Save();
+
+    if (DirtyPackages.Num() == 0 && RemovedPackages.Num() == 0)
+        return true;
+
+    // Initial registry scan reports every asset as added; the snapshot is reconciled with Refresh() instead
+    IAssetRegistry& AssetRegistry = BatchToolsTextureIndex::GetAssetRegistry();
+    if (AssetRegistry.IsLoadingAssets())
+        return true;
+
+    for (FName PackageName : RemovedPackages)
+        RemoveRow(PackageName);
+
+    TArray<FAssetData> ChangedAssets;
+    for (FName PackageName : DirtyPackages)
+    {
+        TArray<FAssetData> PackageAssets;
+        AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets);
+        for (const FAssetData& Asset : PackageAssets)
+        {
+            if (IsIndexedTexture(Asset))
+                ChangedAssets.Add(Asset);
+        }
+    }
+
+    UpdateRows(ChangedAssets);
+
+    UE_LOG(LogBatchTools, Verbose, TEXT("Texture index: %d rows updated, %d removed"), ChangedAssets.Num(), RemovedPackages.Num());
+
+    TArray<FName> ChangedPackages = DirtyPackages.Array();
+    ChangedPackages.Append(RemovedPackages.Array());
+    DirtyPackages.Reset();
+    RemovedPackages.Reset();
+
+    ChangedDelegate.Broadcast();
+    PackagesChangedDelegate.Broadcast(ChangedPackages);
+    return true;
+}
+
+TArray<int32> FBatchToolsTextureIndex::QueryTopN(int32 N) const
+{
+    TArray<int32> Heap;
+    if (N <= 0)
+        return Heap;
+
+    // Min-heap of the N most expensive rows seen so far
+    auto CheaperThan = [this](int32 A, int32 B) { return ResidentBytes[A] < ResidentBytes[B]; };
+    Heap.Reserve(N + 1);
+
+    for (int32 Row = 0; Row < ResidentBytes.Num(); Row++)
+    {
+        if (Heap.Num() < N)
+        {
+            Heap.HeapPush(Row, CheaperThan);
+        }
+        else if (ResidentBytes[Row] > ResidentBytes[Heap.HeapTop()])
+        {
+            Heap.HeapPopDiscard(CheaperThan, EAllowShrinking::No);
+            Heap.HeapPush(Row, CheaperThan);
+        }
+    }
+
+    Heap.Sort([this](int32 A, int32 B) { return ResidentBytes[A] > ResidentBytes[B]; });
+    return Heap;
+}
+
+TArray<FTextureIndexGroup> FBatchToolsTextureIndex::GroupBy(const TArray<FName>& KeyColumn) const
+{
+    TMap<FName, FTextureIndexGroup> Groups;
+    for (int32 Row = 0; Row < KeyColumn.Num(); Row++)
+    {
+        FTextureIndexGroup& Group = Groups.FindOrAdd(KeyColumn[Row]);
+        Group.Key = KeyColumn[Row];
+        Group.Count++;
+        Group.ResidentBytes += ResidentBytes[Row];
+    }
+
+    TArray<FTextureIndexGroup> Result;
+    Groups.GenerateValueArray(Result);
+    Result.Sort([](const FTextureIndexGroup& A, const FTextureIndexGroup& B) { return A.ResidentBytes > B.ResidentBytes; });
+    return Result;
+}
+
+TArray<FTextureIndexGroup> FBatchToolsTextureIndex::QueryGroupByFolder() const
+{
+    return GroupBy(Folders);
+}
+
+TArray<FTextureIndexGroup> FBatchToolsTextureIndex::QueryGroupByLODGroup() const
+{
+    return GroupBy(LODGroups);
+}
+
+TArray<FTextureIndexHistogramBucket> FBatchToolsTextureIndex::QueryHistogram() const
+{
+    // Buckets for 1px .. 16384px, keyed by the power of two at or above the largest dimension
+    const int32 NumBuckets = 15;
+    TArray<FTextureIndexHistogramBucket> Buckets;
+    Buckets.SetNum(NumBuckets);
+    for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+        Buckets[Bucket].MaxDimension = 1 << Bucket;
+
+    for (int32 Row = 0; Row < Widths.Num(); Row++)
+    {
+        const uint32 MaxDimension = FMath::Max<uint32>(1, FMath::Max(Widths[Row], Heights[Row]));
+        const int32 Bucket = FMath::Min<int32>(FMath::CeilLogTwo(MaxDimension), NumBuckets - 1);
+        Buckets[Bucket].Count++;
+        Buckets[Bucket].ResidentBytes += ResidentBytes[Row];
+    }
+
+    return Buckets;
+}
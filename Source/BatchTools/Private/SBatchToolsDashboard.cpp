@@ -0,0 +1,313 @@
+#include "SBatchToolsDashboard.h"
+#include "BatchToolsTextureIndex.h"
+#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSpinBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "FBatchToolsModule"
+
+void SBatchToolsDashboard::Construct(const FArguments& InArgs)
+{
+    Index = InArgs._Index;
+
+    QueryOptions.Add(MakeShareable(new EDashboardQuery(EDashboardQuery::TopN)));
+    QueryOptions.Add(MakeShareable(new EDashboardQuery(EDashboardQuery::ByFolder)));
+    QueryOptions.Add(MakeShareable(new EDashboardQuery(EDashboardQuery::ByLODGroup)));
+    QueryOptions.Add(MakeShareable(new EDashboardQuery(EDashboardQuery::Histogram)));
+    SelectedQuery = QueryOptions[0];
+
+    if (Index.IsValid())
+    {
+        IndexChangedHandle = Index->OnChanged().AddSP(this, &SBatchToolsDashboard::RunQuery);
+    }
+
+    ChildSlot
+    [
+        SNew(SBox)
+        .Padding(10)
+        [
+            SNew(SVerticalBox)
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0, 0, 0, 10)
+            [
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(0, 0, 5, 0)
+                [
+                    SNew(SComboBox<TSharedPtr<EDashboardQuery>>)
+                    .OptionsSource(&QueryOptions)
+                    .InitiallySelectedItem(SelectedQuery)
+                    .OnGenerateWidget(this, &SBatchToolsDashboard::OnGenerateQueryWidget)
+                    .OnSelectionChanged(this, &SBatchToolsDashboard::OnQueryChanged)
+                    [
+                        SNew(STextBlock)
+                        .Text_Lambda([this]() {
+                            return SelectedQuery.IsValid() ? GetQueryLabel(*SelectedQuery) : FText::GetEmpty();
+                        })
+                    ]
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(0, 0, 5, 0)
+                [
+                    SNew(SBox)
+                    .WidthOverride(80)
+                    .IsEnabled_Lambda([this]() { return SelectedQuery.IsValid() && *SelectedQuery == EDashboardQuery::TopN; })
+                    [
+                        SNew(SSpinBox<int32>)
+                        .MinValue(1)
+                        .MaxValue(100000)
+                        .Value_Lambda([this]() { return TopN; })
+                        .OnValueCommitted_Lambda([this](int32 NewValue, ETextCommit::Type) {
+                            TopN = NewValue;
+                            RunQuery();
+                        })
+                    ]
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .VAlign(VAlign_Center)
+                [
+                    SNew(STextBlock)
+                    .Text(this, &SBatchToolsDashboard::GetStatusText)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(5, 0)
+                [
+                    SNew(SButton)
+                    .Text(LOCTEXT("DashboardRefresh", "Refresh"))
+                    .ToolTipText(LOCTEXT("DashboardRefreshTooltip", "Update only textures added, removed or changed since the last snapshot"))
+                    .OnClicked(this, &SBatchToolsDashboard::OnRefreshClicked)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SButton)
+                    .Text(LOCTEXT("DashboardRebuild", "Rebuild"))
+                    .ToolTipText(LOCTEXT("DashboardRebuildTooltip", "Recompute every texture from the Asset Registry"))
+                    .OnClicked(this, &SBatchToolsDashboard::OnRebuildClicked)
+                ]
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(0, 0, 0, 5)
+            [
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .FillWidth(0.45f)
+                [
+                    SNew(STextBlock)
+                    .Text(LOCTEXT("DashboardColumnName", "Name"))
+                    .Font(FCoreStyle::GetDefaultFontStyle("Bold", 9))
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(0.3f)
+                [
+                    SNew(STextBlock)
+                    .Text(LOCTEXT("DashboardColumnDetail", "Details"))
+                    .Font(FCoreStyle::GetDefaultFontStyle("Bold", 9))
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(0.1f)
+                [
+                    SNew(STextBlock)
+                    .Text(LOCTEXT("DashboardColumnCount", "Textures"))
+                    .Font(FCoreStyle::GetDefaultFontStyle("Bold", 9))
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(0.15f)
+                [
+                    SNew(STextBlock)
+                    .Text(LOCTEXT("DashboardColumnSize", "Resident MB"))
+                    .Font(FCoreStyle::GetDefaultFontStyle("Bold", 9))
+                ]
+            ]
+            + SVerticalBox::Slot()
+            .FillHeight(1.0f)
+            [
+                SAssignNew(ListView, SListView<TSharedPtr<FDashboardRow>>)
+                .ListItemsSource(&Rows)
+                .OnGenerateRow(this, &SBatchToolsDashboard::OnGenerateRow)
+                .SelectionMode(ESelectionMode::None)
+            ]
+        ]
+    ];
+
+    RunQuery();
+}
+
+SBatchToolsDashboard::~SBatchToolsDashboard()
+{
+    if (Index.IsValid())
+    {
+        Index->OnChanged().Remove(IndexChangedHandle);
+    }
+}
+
+FText SBatchToolsDashboard::GetQueryLabel(EDashboardQuery Query) const
+{
+    switch (Query)
+    {
+        case EDashboardQuery::TopN:
+            return LOCTEXT("DashboardQueryTopN", "Most Expensive Textures");
+        case EDashboardQuery::ByFolder:
+            return LOCTEXT("DashboardQueryFolder", "Group by Folder");
+        case EDashboardQuery::ByLODGroup:
+            return LOCTEXT("DashboardQueryLODGroup", "Group by LOD Group");
+        case EDashboardQuery::Histogram:
+            return LOCTEXT("DashboardQueryHistogram", "Size Histogram");
+    }
+    return FText::GetEmpty();
+}
+
+FText SBatchToolsDashboard::GetStatusText() const
+{
+    if (!Index.IsValid() || Index->IsEmpty())
+        return LOCTEXT("DashboardEmpty", "No snapshot yet - click Rebuild");
+
+    return FText::Format(LOCTEXT("DashboardStatus", "{0} textures indexed | query took {1} ms"),
+        FText::AsNumber(Index->Num()),
+        FText::AsNumber(LastQueryMilliseconds));
+}
+
+void SBatchToolsDashboard::RunQuery()
+{
+    Rows.Reset();
+
+    if (Index.IsValid() && SelectedQuery.IsValid())
+    {
+        const double StartTime = FPlatformTime::Seconds();
+
+        switch (*SelectedQuery)
+        {
+            case EDashboardQuery::TopN:
+                for (int32 Row : Index->QueryTopN(TopN))
+                {
+                    TSharedPtr<FDashboardRow> Item = MakeShared<FDashboardRow>();
+                    Item->Label = Index->GetPackageName(Row).ToString();
+                    Item->Detail = FString::Printf(TEXT("%dx%d %s LOD %d | %s | %d refs"),
+                        Index->GetWidth(Row), Index->GetHeight(Row), *Index->GetFormat(Row).ToString(), Index->GetLODBias(Row),
+                        Index->HasSourceFile(Row) ? TEXT("source") : TEXT("no source"), Index->GetReferencerCount(Row));
+                    Item->Count = 1;
+                    Item->ResidentBytes = Index->GetResidentBytes(Row);
+                    Rows.Add(Item);
+                }
+                break;
+
+            case EDashboardQuery::ByFolder:
+            case EDashboardQuery::ByLODGroup:
+            {
+                const TArray<FTextureIndexGroup> Groups = *SelectedQuery == EDashboardQuery::ByFolder ? Index->QueryGroupByFolder() : Index->QueryGroupByLODGroup();
+                for (const FTextureIndexGroup& Group : Groups)
+                {
+                    TSharedPtr<FDashboardRow> Item = MakeShared<FDashboardRow>();
+                    Item->Label = Group.Key.ToString();
+                    Item->Count = Group.Count;
+                    Item->ResidentBytes = Group.ResidentBytes;
+                    Rows.Add(Item);
+                }
+                break;
+            }
+
+            case EDashboardQuery::Histogram:
+                for (const FTextureIndexHistogramBucket& Bucket : Index->QueryHistogram())
+                {
+                    if (Bucket.Count == 0)
+                        continue;
+
+                    TSharedPtr<FDashboardRow> Item = MakeShared<FDashboardRow>();
+                    Item->Label = FString::Printf(TEXT("<= %dpx"), Bucket.MaxDimension);
+                    Item->Detail = FString::ChrN(FMath::Clamp(Bucket.Count * 40 / FMath::Max(1, Index->Num()), 1, 40), TEXT('#'));
+                    Item->Count = Bucket.Count;
+                    Item->ResidentBytes = Bucket.ResidentBytes;
+                    Rows.Add(Item);
+                }
+                break;
+        }
+
+        LastQueryMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    }
+
+    if (ListView.IsValid())
+    {
+        ListView->RequestListRefresh();
+    }
+}
+
+TSharedRef<SWidget> SBatchToolsDashboard::OnGenerateQueryWidget(TSharedPtr<EDashboardQuery> Option)
+{
+    return SNew(STextBlock)
+        .Text(GetQueryLabel(*Option));
+}
+
+void SBatchToolsDashboard::OnQueryChanged(TSharedPtr<EDashboardQuery> NewSelection, ESelectInfo::Type SelectInfo)
+{
+    SelectedQuery = NewSelection;
+    RunQuery();
+}
+
+TSharedRef<ITableRow> SBatchToolsDashboard::OnGenerateRow(TSharedPtr<FDashboardRow> Row, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    const FString SizeInfo = FString::Printf(TEXT("%.1f"), Row->ResidentBytes / (1024.0 * 1024.0));
+
+    return SNew(STableRow<TSharedPtr<FDashboardRow>>, OwnerTable)
+    [
+        SNew(SHorizontalBox)
+        + SHorizontalBox::Slot()
+        .FillWidth(0.45f)
+        [
+            SNew(STextBlock)
+            .Text(FText::FromString(Row->Label))
+            .Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+        ]
+        + SHorizontalBox::Slot()
+        .FillWidth(0.3f)
+        [
+            SNew(STextBlock)
+            .Text(FText::FromString(Row->Detail))
+            .Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+        ]
+        + SHorizontalBox::Slot()
+        .FillWidth(0.1f)
+        [
+            SNew(STextBlock)
+            .Text(FText::AsNumber(Row->Count))
+            .Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+        ]
+        + SHorizontalBox::Slot()
+        .FillWidth(0.15f)
+        [
+            SNew(STextBlock)
+            .Text(FText::FromString(SizeInfo))
+            .Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+        ]
+    ];
+}
+
+FReply SBatchToolsDashboard::OnRefreshClicked()
+{
+    if (Index.IsValid())
+    {
+        if (Index->IsEmpty())
+            Index->Build();
+        else
+            Index->Refresh();
+    }
+    return FReply::Handled();
+}
+
+FReply SBatchToolsDashboard::OnRebuildClicked()
+{
+    if (Index.IsValid())
+    {
+        Index->Build();
+    }
+    return FReply::Handled();
+}
+
+#undef LOCTEXT_NAMESPACE
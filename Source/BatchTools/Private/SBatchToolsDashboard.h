@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class FBatchToolsTextureIndex;
+
+// Dockable read-only view over the texture cost index
+class SBatchToolsDashboard : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SBatchToolsDashboard) {}
+        SLATE_ARGUMENT(TSharedPtr<FBatchToolsTextureIndex>, Index)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+    virtual ~SBatchToolsDashboard();
+
+private:
+    enum class EDashboardQuery : uint8
+    {
+        TopN,
+        ByFolder,
+        ByLODGroup,
+        Histogram
+    };
+
+    struct FDashboardRow
+    {
+        FString Label;
+        FString Detail;
+        int32 Count = 0;
+        int64 ResidentBytes = 0;
+    };
+
+    void RunQuery();
+    FText GetQueryLabel(EDashboardQuery Query) const;
+    FText GetStatusText() const;
+
+    TSharedRef<SWidget> OnGenerateQueryWidget(TSharedPtr<EDashboardQuery> Option);
+    void OnQueryChanged(TSharedPtr<EDashboardQuery> NewSelection, ESelectInfo::Type SelectInfo);
+    TSharedRef<ITableRow> OnGenerateRow(TSharedPtr<FDashboardRow> Row, const TSharedRef<STableViewBase>& OwnerTable);
+    FReply OnRefreshClicked();
+    FReply OnRebuildClicked();
+
+    TSharedPtr<FBatchToolsTextureIndex> Index;
+    FDelegateHandle IndexChangedHandle;
+
+    TArray<TSharedPtr<EDashboardQuery>> QueryOptions;
+    TSharedPtr<EDashboardQuery> SelectedQuery;
+    int32 TopN = 100;
+
+    TArray<TSharedPtr<FDashboardRow>> Rows;
+    TSharedPtr<SListView<TSharedPtr<FDashboardRow>>> ListView;
+    double LastQueryMilliseconds = 0.0;
+};
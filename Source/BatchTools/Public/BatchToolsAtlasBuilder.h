@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/TextureDefines.h"
+#include "BatchToolsAtlasBuilder.generated.h"
+
+class UTexture2D;
+
+// Where one source texture ended up
+USTRUCT(BlueprintType)
+struct FBatchToolsAtlasSprite
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "BatchTools")
+    TSoftObjectPtr<UTexture2D> SourceTexture;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "BatchTools")
+    TObjectPtr<UTexture2D> Atlas;
+
+    // Min UV in X/Y, max UV in Z/W, padding excluded
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "BatchTools")
+    FVector4f UVRect = FVector4f(0.0f, 0.0f, 1.0f, 1.0f);
+};
+
+// UV-rect lookup written next to the generated atlases
+UCLASS(BlueprintType)
+class UBatchToolsAtlasLookup : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "BatchTools")
+    TArray<TObjectPtr<UTexture2D>> Atlases;
+
+    // Keyed by the source texture's object path
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "BatchTools")
+    TMap<FSoftObjectPath, FBatchToolsAtlasSprite> Sprites;
+
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    bool FindSprite(const TSoftObjectPtr<UTexture2D>& SourceTexture, FBatchToolsAtlasSprite& OutSprite) const;
+};
+
+// Atlas settings from the [BatchTools.Atlas] section of DefaultBatchTools.ini
+struct FBatchToolsAtlasSettings
+{
+    // Textures up to this size are gathered
+    int32 MaxSourceSize = 256;
+    // Sprites are resampled to fit this size
+    int32 MaxSpriteSize = 256;
+    int32 AtlasSize = 2048;
+    // Border around each sprite so filtering and mips do not bleed
+    int32 Padding = 2;
+    // Content folder for the atlases and their lookup; empty puts them in an Atlases subfolder of the first selected folder
+    FString OutputFolder;
+
+    static FBatchToolsAtlasSettings Load();
+};
+
+// One texture to pack, sized by the caller
+struct FBatchToolsAtlasInput
+{
+    UTexture2D* Texture = nullptr;
+    int32 Width = 0;
+    int32 Height = 0;
+    int64 ResidentBytes = 0;
+};
+
+struct FBatchToolsAtlasReport
+{
+    int32 NumSprites = 0;
+    int32 NumAtlases = 0;
+    int32 NumUnpacked = 0;
+    int64 BeforeResidentBytes = 0;
+    int64 AfterResidentBytes = 0;
+    double PackSeconds = 0.0;
+    UBatchToolsAtlasLookup* Lookup = nullptr;
+};
+
+// Bottom-left skyline packer; the skyline is a list of horizontal segments
+class FBatchToolsSkylinePacker
+{
+public:
+    FBatchToolsSkylinePacker(int32 InWidth, int32 InHeight);
+
+    // False when the rect does not fit anywhere
+    bool Insert(int32 RectWidth, int32 RectHeight, FIntPoint& OutPosition);
+
+    int32 GetUsedWidth() const { return UsedWidth; }
+    int32 GetUsedHeight() const { return UsedHeight; }
+
+private:
+    struct FSegment
+    {
+        int32 X;
+        int32 Y;
+        int32 Width;
+    };
+
+    // Y the rect would rest at when placed at the start of segment Index, or INDEX_NONE
+    int32 FitAt(int32 Index, int32 RectWidth, int32 RectHeight) const;
+
+    int32 Width;
+    int32 Height;
+    int32 UsedWidth = 0;
+    int32 UsedHeight = 0;
+    TArray<FSegment> Skyline;
+};
+
+// Packs small textures into shared atlases, grouped by compression settings and compressed format so each
+// atlas compresses to the format its sprites already use
+class FBatchToolsAtlasBuilder
+{
+public:
+    static FBatchToolsAtlasReport Build(const TArray<FBatchToolsAtlasInput>& Inputs, const FString& OutputFolder, const FBatchToolsAtlasSettings& Settings);
+
+private:
+    struct FPlacement
+    {
+        int32 InputIndex = INDEX_NONE;
+        int32 PageIndex = INDEX_NONE;
+        FIntPoint Position = FIntPoint::ZeroValue;
+    };
+
+    // Packs the inputs onto as many pages as needed, largest first; each page is sized to its used
+    // area rounded up to a power of two
+    static int32 Pack(const TArray<FBatchToolsAtlasInput>& Inputs, const TArray<int32>& InputIndices, const FBatchToolsAtlasSettings& Settings, TArray<FPlacement>& OutPlacements, TArray<FIntPoint>& OutPageSizes);
+
+    // bNoAlpha keeps an atlas of opaque sprites in an opaque format, since its empty space is transparent
+    static UTexture2D* CreateAtlasTexture(const FString& PackageName, int32 Width, int32 Height, const TArray<FColor>& Pixels, const UTexture2D* Template, bool bNoAlpha);
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "BatchToolsResultTable.h"
+
+class USoundWave;
+
+// Audio optimization settings from the [BatchTools.Audio] section of DefaultBatchTools.ini
+struct FBatchToolsAudioSettings
+{
+    // Estimated compressed size allowed for the whole batch; 0 only lowers sample rates
+    float BudgetMB = 0.0f;
+    // Compression quality is never lowered below this
+    int32 MinQuality = 20;
+    // Share of the spectral energy that must stay below the new Nyquist frequency
+    float SpectralRolloff = 0.995f;
+    // Analysis reads at most this much audio per wave, spread evenly over its length
+    float MaxAnalysisSeconds = 30.0f;
+    // Looping waves (ambient beds) get this share of the batch quality
+    float LoopQualityScale = 0.75f;
+    // Waves shorter than this keep their settings
+    float MinDurationSeconds = 0.5f;
+    // Rebuild compressed data for the running platform after the batch
+    bool bRebuildCompressedData = true;
+    // Longest wait for that rebuild; cancelling the progress dialog also stops waiting
+    float RebuildTimeoutSeconds = 120.0f;
+
+    static FBatchToolsAudioSettings Load();
+};
+
+// Picks a sample-rate setting and compression quality per sound wave. Imported PCM is analyzed on
+// worker threads, settings are applied without rebuilding, and compressed data is invalidated and
+// rebuilt once for the whole batch.
+class FBatchToolsAudioOptimizer
+{
+public:
+    static FTextureOptimizationResultTable Run(const TArray<FAssetData>& SoundWaves, const FBatchToolsAudioSettings& Settings);
+
+    // Highest frequency below which Rolloff of the energy lies, from a mono downmix of 16-bit PCM
+    static float AnalyzeBandwidth(const int16* Samples, int32 NumFrames, int32 NumChannels, int32 SampleRate, float Rolloff, float MaxSeconds);
+
+    // Compressed size model: bits per sample grow with quality and scale with sample rate
+    static int64 EstimateCompressedBytes(float DurationSeconds, int32 NumChannels, float SampleRate, int32 Quality);
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BatchToolsBenchmarkCommandlet.generated.h"
+
+/**
+ * Runs the optimization pipeline on synthetic textures in the transient package and compares
+ * per-stage wall time, peak memory growth and throughput against a baseline JSON. Returns 1 on a regression
+ * or when the baseline is missing; -WriteBaseline records the baseline instead of comparing.
+ *
+ * UnrealEditor-Cmd Project.uproject -run=BatchToolsBenchmark -nullrhi [-Count=2000] [-Tolerance=0.25] [-Baseline=Path.json] [-WriteBaseline]
+ */
+UCLASS()
+class UBatchToolsBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBatchToolsBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+// One folder budget from the [BatchTools.Budgets] section of DefaultBatchTools.ini, e.g.
+//   +Folders=(Path="/Game/Env", MaxMemoryMB=2048)
+//   +Folders=(Path="/Game/Env/Foliage", MaxMemoryMB=256)
+struct FFolderBudget
+{
+    FString Path;
+    float MaxMemoryMB = 0.0f;
+
+    static bool Parse(const FString& BudgetText, FFolderBudget& OutBudget);
+};
+
+// Budget tree settings from the [BatchTools.Budgets] section of DefaultBatchTools.ini
+struct FBatchToolsBudgetSettings
+{
+    TArray<FFolderBudget> Folders;
+    // Root of the tree; rollups include every texture under it
+    FString RootPath = TEXT("/Game");
+    // Most LOD bias steps added to one texture by a single enforcement
+    int32 MaxExtraLODBias = 3;
+    // Textures are never biased below this size
+    int32 MinSize = 64;
+
+    static FBatchToolsBudgetSettings Load();
+};
+
+// LOD bias one texture needs so its folders fit their targets. The bias is absolute, so applying a
+// plan twice, or after the texture was already biased further, never stacks the reduction.
+struct FBudgetReduction
+{
+    FName PackageName;
+    int32 TargetLODBias = 0;
+};
+
+// Texture memory per content folder, rolled up to the root. A folder's target is its own budget plus
+// the unused headroom of its parent, capped by its proportional share when the parent is over.
+// Folders without a budget inherit the parent's constraint. Rollups are kept current per asset
+// by walking one path to the root; targets are recomputed lazily along the queried path.
+class FBatchToolsBudgetTree
+{
+public:
+    // Full build: costs are read from registry tags in parallel, then rolled up one depth level at a time
+    void Build(const FBatchToolsBudgetSettings& InSettings);
+
+    // Replaces the folder budgets and limits without rebuilding rollups
+    void ApplySettings(const FBatchToolsBudgetSettings& InSettings);
+
+    // Incremental updates for one asset; only the folders between it and the root are touched
+    void UpdateAsset(const FAssetData& Asset);
+    void RemoveAsset(FName PackageName);
+
+    // Weighted LOD bias plan for the textures under Paths that brings every over-budget folder to its target
+    TArray<FBudgetReduction> PlanReductions(const TArray<FString>& Paths) const;
+
+    int32 NumFolders() const { return Nodes.Num(); }
+    int32 FindFolder(FName Path) const;
+    FName GetFolderPath(int32 Folder) const { return Nodes[Folder].Path; }
+    int64 GetRollupBytes(int32 Folder) const { return Nodes[Folder].RollupBytes; }
+    int64 GetBudgetBytes(int32 Folder) const { return Nodes[Folder].BudgetBytes; }
+    int64 GetTargetBytes(int32 Folder) const;
+    bool IsOverBudget(int32 Folder) const { return Nodes[Folder].RollupBytes > GetTargetBytes(Folder); }
+
+    // Folders under Paths that have a budget of their own or are over their target, parents first
+    TArray<int32> GetReportedFolders(const TArray<FString>& Paths) const;
+
+    bool IsBuilt() const { return Nodes.Num() > 0; }
+    const FString& GetRootPath() const { return Settings.RootPath; }
+
+private:
+    struct FFolderNode
+    {
+        FName Path;
+        int32 Parent = INDEX_NONE;
+        int32 Depth = 0;
+        TArray<int32> Children;
+        TArray<FName> Assets;
+        int64 OwnBytes = 0;
+        int64 RollupBytes = 0;
+        int64 BudgetBytes = 0;
+
+        // Lazily computed from the ancestors; valid while TargetVersion matches the tree
+        mutable int64 TargetBytes = 0;
+        mutable uint32 TargetVersion = 0;
+    };
+
+    struct FAssetCost
+    {
+        int32 Folder = INDEX_NONE;
+        int32 Width = 0;
+        int32 Height = 0;
+        int32 LODBias = 0;
+        FName Format;
+        int64 Bytes = 0;
+        float Weight = 1.0f;
+    };
+
+    int32 FindOrAddFolder(FName Path);
+    void AddToPath(int32 Folder, int64 DeltaBytes);
+    static bool ReadCost(const FAssetData& Asset, FAssetCost& OutCost);
+    bool IsUnderPaths(int32 Folder, const TArray<FString>& Paths) const;
+
+    FBatchToolsBudgetSettings Settings;
+    TArray<FFolderNode> Nodes;
+    TMap<FName, int32> NodeByPath;
+    TMap<FName, FAssetCost> AssetCosts;
+    int32 RootFolder = INDEX_NONE;
+
+    // Bumped by every change so cached targets are recomputed on the next query
+    uint32 Version = 1;
+};
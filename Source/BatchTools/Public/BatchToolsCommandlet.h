@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BatchToolsCommandlet.generated.h"
+
+/**
+ * Runs a texture optimization batch without the editor UI, using the same project policy as the menus.
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=BatchTools -Paths=/Game/Env,/Game/Props -Method=Smart -Target=1024 [-Workers=8] [-Save] [-PrewarmDDC]
+ *
+ * With -Telemetry=D:/Captures,run7.csv the LOD bias is set from recorded streaming captures instead.
+ * With -Budgets the LOD bias is raised until each folder fits its [BatchTools.Budgets] rollup target.
+ * -Meshes also fits the static meshes under the paths to their [BatchTools.Mesh] folder budgets.
+ * -Sounds also fits the sound waves under the paths to the [BatchTools.Audio] budget.
+ */
+UCLASS()
+class UBatchToolsCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBatchToolsCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
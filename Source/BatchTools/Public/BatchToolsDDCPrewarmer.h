@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+// Forward declarations
+class ITargetPlatform;
+class UTexture;
+
+// Prewarm settings from the [BatchTools.DDCPrewarm] section of DefaultBatchTools.ini
+struct FBatchToolsDDCPrewarmSettings
+{
+    bool bEnabled = false;
+    // Platform names (e.g. Windows, Android_ASTC); empty means the active target platforms
+    TArray<FString> TargetPlatforms;
+    // Platform data builds kept in flight at once
+    int32 MaxInFlight = 16;
+    // Builds finishing faster than this are counted as cache hits, slower ones as misses
+    float HitThresholdMs = 50.0f;
+
+    static FBatchToolsDDCPrewarmSettings Load();
+};
+
+// Per-texture prewarm timing, summed over all target platforms
+struct FDDCPrewarmTextureStats
+{
+    FString TextureName;
+    double BuildSeconds = 0.0;
+    int32 Hits = 0;
+    int32 Misses = 0;
+    // Completion was seen too late to tell a hit from a miss, e.g. while the editor was throttled
+    int32 Unclassified = 0;
+};
+
+// Queues cooked platform data builds for modified textures in the background so the next cook
+// finds them in the local DDC instead of recompressing on demand
+class FBatchToolsDDCPrewarmer
+{
+public:
+    FBatchToolsDDCPrewarmer(const FBatchToolsDDCPrewarmSettings& InSettings);
+    ~FBatchToolsDDCPrewarmer();
+
+    void Prewarm(const TArray<UTexture*>& Textures);
+
+    // Blocks until the queue is empty (commandlets exit right after the batch)
+    void WaitForCompletion();
+
+    bool IsIdle() const { return PendingJobs.Num() == 0 && ActiveJobs.Num() == 0; }
+
+private:
+    struct FPrewarmJob
+    {
+        TWeakObjectPtr<UTexture> Texture;
+        const ITargetPlatform* Platform = nullptr;
+        double StartTime = 0.0;
+        int32 StatsIndex = INDEX_NONE;
+    };
+
+    bool Tick(float DeltaTime);
+    void ReportAndReset();
+
+    FBatchToolsDDCPrewarmSettings Settings;
+    TArray<const ITargetPlatform*> Platforms;
+
+    TArray<FPrewarmJob> PendingJobs;
+    TArray<FPrewarmJob> ActiveJobs;
+    int32 NextPendingJob = 0;
+
+    TArray<FDDCPrewarmTextureStats> Stats;
+    TMap<FObjectKey, int32> StatsByTexture;
+    double PrewarmStartTime = 0.0;
+    // When the queue was last polled; a job finished somewhere between this and the poll that saw it
+    double LastPollTime = 0.0;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+};
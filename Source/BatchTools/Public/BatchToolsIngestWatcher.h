@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/GCObject.h"
+#include "BatchToolsModule.h"
+
+// Forward declarations
+class UFactory;
+class UTexture;
+
+// Ingest settings from the [BatchTools.Ingest] section of DefaultBatchTools.ini
+struct FBatchToolsIngestSettings
+{
+    bool bEnabled = false;
+    EOptimizationMethod Method = EOptimizationMethod::LODBiasOnly;
+    int32 TargetResolution = 2048;
+    // Quiet time after the last import before a burst is processed
+    float CoalesceSeconds = 2.0f;
+    // Game thread time spent per tick once a burst is processed
+    float TimeBudgetMs = 5.0f;
+
+    static FBatchToolsIngestSettings Load();
+};
+
+// Queues textures as they are imported and optimizes them in small time slices once the import burst is over.
+// The burst is one texture batch, so max in-game size changes are built together when the queue drains.
+class FBatchToolsIngestWatcher : public FGCObject
+{
+public:
+    FBatchToolsIngestWatcher(FBatchToolsModule& InModule, const FBatchToolsIngestSettings& InSettings);
+    virtual ~FBatchToolsIngestWatcher() override;
+
+    // FGCObject keeps the textures of the open batch alive between ticks
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override { return TEXT("FBatchToolsIngestWatcher"); }
+
+    int32 NumPending() const { return PendingTextures.Num(); }
+
+private:
+    void OnAssetPostImport(UFactory* Factory, UObject* CreatedObject);
+    void OnAssetReimport(UObject* ReimportedObject);
+    void Enqueue(UObject* Object);
+    bool Tick(float DeltaTime);
+
+    FBatchToolsModule& Module;
+    FBatchToolsIngestSettings Settings;
+
+    TArray<TWeakObjectPtr<UTexture>> PendingTextures;
+    TSet<FObjectKey> PendingKeys;
+    double LastImportTime = 0.0;
+    bool bProcessing = false;
+
+    // Textures of the current burst, finished once the queue is empty
+    FTextureBatch Batch;
+
+    FDelegateHandle PostImportHandle;
+    FDelegateHandle ReimportHandle;
+    FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "BatchToolsResultTable.h"
+
+class UStaticMesh;
+
+// One folder budget from the [BatchTools.Mesh] section of DefaultBatchTools.ini, e.g.
+//   +Budgets=(Path="/Game/Env", MaxTriangles=5000000, MaxMemoryMB=512)
+// The deepest budget containing a mesh applies; 0 means unlimited.
+struct FMeshFolderBudget
+{
+    FString Path;
+    int64 MaxTriangles = 0;
+    float MaxMemoryMB = 0.0f;
+
+    static bool Parse(const FString& BudgetText, FMeshFolderBudget& OutBudget);
+};
+
+// Mesh optimization settings from the [BatchTools.Mesh] section of DefaultBatchTools.ini
+struct FBatchToolsMeshSettings
+{
+    TArray<FMeshFolderBudget> Budgets;
+    // Non-Nanite meshes with fewer LODs get generated ones up to this count
+    int32 NumLODs = 4;
+    // Triangle ratio between consecutive generated LODs
+    float LODReduction = 0.5f;
+    // LOD0 and the Nanite fallback are never reduced below this share of their triangles
+    float MinPercentTriangles = 0.1f;
+    // Meshes with fewer LOD0 triangles are never reduced
+    int32 MinTriangles = 500;
+
+    static FBatchToolsMeshSettings Load();
+
+    // Deepest budget whose path contains the package path, or null
+    const FMeshFolderBudget* FindBudget(FName PackagePath) const;
+};
+
+// Shrinks static meshes in folders over their triangle or memory budget. Reduction and LOD
+// settings are changed on every mesh first, then all of them are rebuilt in one batched async build.
+class FBatchToolsMeshOptimizer
+{
+public:
+    static FTextureOptimizationResultTable Run(const TArray<FAssetData>& Meshes, const FBatchToolsMeshSettings& Settings);
+
+private:
+    struct FMeshStats
+    {
+        uint32 Vertices = 0;
+        uint32 Indices = 0;
+        uint32 Triangles = 0;
+        int64 LOD0Bytes = 0;
+        int64 Bytes = 0;
+    };
+
+    // LOD0 of the render data, which is the fallback mesh for Nanite meshes
+    static FMeshStats GatherStats(UStaticMesh* Mesh);
+
+    // Bytes of the LODs ApplyReduction would generate, as a multiple of the reduced LOD0's bytes
+    static float GeneratedLODShare(UStaticMesh* Mesh, const FBatchToolsMeshSettings& Settings);
+
+    // Scales LOD0 or the Nanite fallback by TriangleScale without building
+    static EOptimizationMethod ApplyReduction(UStaticMesh* Mesh, float TriangleScale, const FMeshStats& Stats, const FBatchToolsMeshSettings& Settings);
+};
@@ -5,36 +5,23 @@
 #include "Framework/Commands/Commands.h"
 #include "Framework/MultiBox/MultiBoxExtender.h"
 #include "AssetRegistry/AssetData.h"
+#include "BatchToolsResultTable.h"
+#include "BatchToolsStreamingSimulator.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogBatchTools, Log, All);
 
 // Forward declarations
 class UTexture;
 class FMenuBuilder;
-
-// Optimization methods
-enum class EOptimizationMethod : uint8
-{
-    LODBiasOnly,
-    ReimportOnly,
-    SmartAuto
-};
-
-// Result structure
-struct FTextureOptimizationResult
-{
-    FString TextureName;
-    int32 OriginalWidth = 0;
-    int32 OriginalHeight = 0;
-    int32 FinalWidth = 0;
-    int32 FinalHeight = 0;
-    float VRAMSavedMB = 0.0f;
-    float FileSizeSavedMB = 0.0f;
-    bool bSuccess = false;
-    bool bHadSourceFile = false;
-    EOptimizationMethod MethodUsed = EOptimizationMethod::LODBiasOnly;
-    FString ErrorMessage;
-};
+class FBatchToolsIngestWatcher;
+class FBatchToolsDDCPrewarmer;
+class FBatchToolsSourceProxyCache;
+class FBatchToolsStreamingTelemetry;
+class FBatchToolsBudgetTree;
+class FBatchToolsTextureIndex;
+class SDockTab;
+class FSpawnTabArgs;
+struct FTexturePolicyDecision;
 
 // Custom widget para o dialog de resolução
 class SResolutionDialog : public SCompoundWidget
@@ -74,6 +61,26 @@ public:
     TSharedPtr<FUICommandInfo> HybridOptimize;
     TSharedPtr<FUICommandInfo> LODBiasOptimize;
     TSharedPtr<FUICommandInfo> ReimportOptimize;
+    TSharedPtr<FUICommandInfo> MaxSizeOptimize;
+};
+
+// Max in-game size change whose cooked size is read after one batched texture build
+struct FPendingCookSize
+{
+    UTexture* Texture = nullptr;
+    int32 ResultIndex = INDEX_NONE;
+    int64 CookedBytesBefore = 0;
+};
+
+// Texture batch fed one texture at a time, so callers can spread it over editor ticks.
+// ProcessTextures runs one from start to finish.
+struct FTextureBatch
+{
+    FTextureOptimizationResultTable Results;
+    // Mip chain of each row captured before the texture changed
+    TArray<FStreamingSimulationTexture> StreamingTextures;
+    TArray<UTexture*> OptimizedTextures;
+    TArray<FPendingCookSize> PendingCookSizes;
 };
 
 // Main module class
@@ -83,46 +90,103 @@ public:
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
 
+    // Project settings live in Config/DefaultBatchTools.ini
+    static const FString& GetConfigFilename();
+
+    // Headless batch entry points shared by the menus and UBatchToolsCommandlet
+    FTextureOptimizationResultTable ProcessTextures(const TArray<FAssetData>& Assets, EOptimizationMethod Method, int32 TargetResolution, FStreamingSimulationReport* OutStreamingReport = nullptr);
+    TArray<FAssetData> GetTexturesFromPaths(const TArray<FString>& Paths);
+    TArray<FAssetData> GetAssetsFromPaths(const TArray<FString>& Paths, const TArray<FTopLevelAssetPath>& ClassPaths);
+    // With OutPendingCookSizes, max in-game size changes are not built; the caller finishes them in one batch
+    FTextureOptimizationResult OptimizeTextureWithPolicy(UTexture* Texture, const FTexturePolicyDecision& Decision, EOptimizationMethod Method, int32 TargetResolution, TArray<FPendingCookSize>* OutPendingCookSizes = nullptr);
+
+    // Optimizes one texture into Batch and returns its row; max in-game size builds wait for FinishTextureBatch
+    int32 AddToTextureBatch(FTextureBatch& Batch, UTexture* Texture, const FTexturePolicyDecision& Decision, EOptimizationMethod Method, int32 TargetResolution);
+    // Builds the pending max in-game sizes together, prewarms the DDC and simulates the streaming pool
+    void FinishTextureBatch(FTextureBatch& Batch, FStreamingSimulationReport* OutStreamingReport = nullptr);
+
+    // Dry run of OptimizeTexture from known dimensions, nothing is loaded or modified
+    FTextureOptimizationResult PlanTexture(FName TextureName, int32 Width, int32 Height, bool bHasSourceFile, EOptimizationMethod Method, int32 TargetResolution);
+
+    // Raises LOD bias to drop the mips no recorded playtest requested ([BatchTools.Telemetry]); textures
+    // without telemetry are left out of the results
+    FTextureOptimizationResultTable ApplyStreamingTelemetry(const TArray<FAssetData>& Assets, const FBatchToolsStreamingTelemetry& Telemetry, FStreamingSimulationReport* OutStreamingReport = nullptr);
+
+    // Reduces static meshes in folders over their [BatchTools.Mesh] budgets, rebuilt in one batch
+    FTextureOptimizationResultTable ProcessStaticMeshes(const TArray<FAssetData>& Assets);
+
+    // Lowers sample rate and compression quality of sound waves to the [BatchTools.Audio] budget
+    FTextureOptimizationResultTable ProcessSoundWaves(const TArray<FAssetData>& Assets);
+
+    // Raises LOD bias under Paths until every folder fits its [BatchTools.Budgets] target; the result
+    // starts with one row per budgeted or over-budget folder
+    FTextureOptimizationResultTable EnforceFolderBudgets(const TArray<FString>& Paths);
+
+    // Builds cooked platform data for optimized textures in the background ([BatchTools.DDCPrewarm])
+    void PrewarmDerivedData(const TArray<UTexture*>& Textures);
+    void WaitForDerivedData();
+
 private:
+    void OnPostEngineInit();
+    void OnAssetRegistryFilesLoaded();
+    TSharedRef<SDockTab> SpawnDashboardTab(const FSpawnTabArgs& Args);
+
     // Menu extension functions
     void RegisterMenuExtensions();
     void UnregisterMenuExtensions();
     TSharedRef<FExtender> OnExtendContentBrowserAssetSelectionMenu(const TArray<FAssetData>& SelectedAssets);
     TSharedRef<FExtender> OnExtendContentBrowserPathSelectionMenu(const TArray<FString>& SelectedPaths);
-    void CreateAssetContextMenu(FMenuBuilder& MenuBuilder, TArray<FAssetData> SelectedAssets);
-    void CreatePathContextMenu(FMenuBuilder& MenuBuilder, TArray<FString> SelectedPaths);
+    void CreateAssetContextMenu(FMenuBuilder& MenuBuilder);
+    void CreatePathContextMenu(FMenuBuilder& MenuBuilder);
 
     // Execution functions
     void ExecuteSmartOptimize();
     void ExecuteHybridOptimize();
     void ExecuteLODBiasOptimize();
     void ExecuteReimportOptimize();
+    void ExecuteMaxSizeOptimize();
+    void ExecuteBuildAtlases();
+    void ExecuteApplyTelemetry();
+    void ExecuteOptimizeMeshes();
+    void ExecuteOptimizeSounds();
+    void ExecuteEnforceBudgets();
     bool CanExecuteOptimization() const;
 
     // Optimization functions
     void OptimizeTextures(EOptimizationMethod Method);
-    void OptimizeTexturesInAssets(TArray<FAssetData> Assets, EOptimizationMethod Method, int32 TargetResolution);
-    void OptimizeTexturesInPaths(TArray<FString> Paths, EOptimizationMethod Method, int32 TargetResolution);
-    FTextureOptimizationResult OptimizeTexture(UTexture* Texture, int32 TargetResolution, EOptimizationMethod Method);
+    void OptimizeTexturesInAssets(const TArray<FAssetData>& Assets, EOptimizationMethod Method, int32 TargetResolution);
+    void OptimizeTexturesInPaths(const TArray<FString>& Paths, EOptimizationMethod Method, int32 TargetResolution);
+    void BuildAtlasesInPaths(const TArray<FString>& Paths);
+    void ApplyTelemetryInPaths(const TArray<FString>& Paths);
+    void OptimizeMeshesInAssets(const TArray<FAssetData>& Assets);
+    void OptimizeSoundsInAssets(const TArray<FAssetData>& Assets);
+    void EnforceBudgetsInPaths(const TArray<FString>& Paths);
+    void OnTexturePackagesChanged(const TArray<FName>& PackageNames);
+    FTextureOptimizationResult OptimizeTexture(UTexture* Texture, int32 TargetResolution, EOptimizationMethod Method, TArray<FPendingCookSize>* OutPendingCookSizes = nullptr);
     FTextureOptimizationResult OptimizeWithLODBias(UTexture* Texture, int32 TargetResolution);
     FTextureOptimizationResult OptimizeWithReimport(UTexture* Texture, int32 TargetResolution);
+    FTextureOptimizationResult OptimizeWithMaxInGameSize(UTexture* Texture, int32 TargetResolution, TArray<FPendingCookSize>* OutPendingCookSizes = nullptr);
+    void ReadCookedSize(UTexture* Texture, int64 CookedBytesBefore, FTextureOptimizationResult& Result);
+    void FinishPendingCookSizes(const TArray<FPendingCookSize>& PendingCookSizes, FTextureOptimizationResultTable& Results);
     
     // Helper functions
     int32 CalculateLODBias(int32 CurrentSize, int32 TargetSize);
     float CalculateFileSizeMB(int32 Width, int32 Height);
+    int64 CalculateCookedSizeBytes(UTexture* Texture);
     bool IsPowerOfTwo(int32 Value);
     FIntPoint CalculateProportionalSize(int32 OriginalWidth, int32 OriginalHeight, int32 TargetResolution);
     int32 CalculateUniversalLODBias(int32 OriginalWidth, int32 OriginalHeight, int32 TargetResolution);
 
     // Utility functions
-    TArray<FAssetData> GetTexturesFromPaths(TArray<FString> Paths);
     bool DoesSourceFileExist(UTexture* Texture);
     EOptimizationMethod ChooseOptimizationMethod(EOptimizationMethod Requested, bool bHasSource);
     void ShowResolutionDialog(EOptimizationMethod Method);
-    void ShowOptimizationResults(TArray<FTextureOptimizationResult> Results);
+    void ShowOptimizationResults(FTextureOptimizationResultTable&& Results, const FStreamingSimulationReport& StreamingReport);
 
-    // State variables
+    // State variables; the selection buffers are reused between menu opens
     TArray<FAssetData> CachedSelectedAssets;
+    TArray<FAssetData> CachedSelectedMeshes;
+    TArray<FAssetData> CachedSelectedSounds;
     TArray<FString> CachedSelectedPaths;
     bool bHasAssetSelection = false;
     int32 DefaultTargetResolution = 512;
@@ -130,6 +194,21 @@ private:
     // Dialog state
     TSharedPtr<SWindow> CurrentDialogWindow;
 
+    // Opt-in optimization of newly imported textures
+    TUniquePtr<FBatchToolsIngestWatcher> IngestWatcher;
+
+    // Texture cost snapshot behind the dashboard tab
+    TSharedPtr<FBatchToolsTextureIndex> TextureIndex;
+
+    // Cooked platform data builds queued after a batch
+    TUniquePtr<FBatchToolsDDCPrewarmer> DDCPrewarmer;
+
+    // Decoded source pyramids shared by reimport trials
+    TUniquePtr<FBatchToolsSourceProxyCache> SourceProxyCache;
+
+    // Folder rollups, kept current from texture index events after the first enforcement
+    TUniquePtr<FBatchToolsBudgetTree> BudgetTree;
+
 public:
     // Public para ser chamado pelo widget
     void ExecuteOptimizationWithResolution(int32 Resolution, EOptimizationMethod Method);
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "BatchToolsModule.h"
+
+// One rule from the [BatchTools.Policy] section of DefaultBatchTools.ini, e.g.
+//   +Rules=(Path="/Game/UI/**", Action=Skip)
+//   +Rules=(Name="*_N", TextureType=NormalMap, MaxSize=1024)
+//   +Rules=(LODGroup=World, BudgetWeight=2.0)
+// Every rule whose conditions all match applies; later rules override earlier ones.
+struct FTexturePolicyRule
+{
+    // Conditions (empty = any)
+    FString PathPattern;
+    FString NamePattern;
+    FName LODGroup;
+
+    // Actions
+    TOptional<bool> bSkip;
+    TOptional<bool> bNormalMap;
+    TOptional<int32> MaxSize;
+    TOptional<float> BudgetWeight;
+    TOptional<EOptimizationMethod> Method;
+
+    static bool Parse(const FString& RuleText, FTexturePolicyRule& OutRule);
+};
+
+// Effective policy for one asset after all matching rules are applied
+struct FTexturePolicyDecision
+{
+    bool bSkip = false;
+    bool bNormalMap = false;
+    int32 MaxSize = 0;
+    float BudgetWeight = 1.0f;
+    TOptional<EOptimizationMethod> Method;
+
+    // Target resolution after the MaxSize cap
+    int32 ClampTarget(int32 TargetResolution) const { return MaxSize > 0 ? FMath::Min(TargetResolution, MaxSize) : TargetResolution; }
+};
+
+// Rules compiled into a path-segment prefix trie plus precompiled globs
+class FBatchToolsPolicy
+{
+public:
+    // Rules compiled at module startup; safe to read from any thread
+    static const FBatchToolsPolicy& Get();
+    // Rereads DefaultBatchTools.ini from disk and recompiles the rules. Game thread only, and also
+    // run by the BatchTools.ReloadPolicy console command after the ini was edited.
+    static void Reload();
+
+    void Compile(const TArray<FTexturePolicyRule>& InRules);
+
+    FTexturePolicyDecision Evaluate(const FAssetData& Asset) const;
+
+    // Evaluates the whole batch in parallel, one decision per asset
+    TArray<FTexturePolicyDecision> EvaluateBatch(const TArray<FAssetData>& Assets) const;
+
+    int32 NumRules() const { return Rules.Num(); }
+
+private:
+    // '*' and '?' inside a single path segment or asset name
+    struct FGlob
+    {
+        FString Pattern;
+        bool bMatchAll = true;
+
+        void Compile(const FString& InPattern);
+        bool Matches(const TCHAR* Text, int32 TextLen) const;
+    };
+
+    struct FCompiledRule
+    {
+        FTexturePolicyRule Rule;
+        // Path segments after the literal prefix; "**" matches any number of segments
+        TArray<FGlob> RemainingSegments;
+        FGlob NameGlob;
+    };
+
+    struct FTrieNode
+    {
+        TMap<FName, int32> Children;
+        TArray<int32> RuleIndices;
+    };
+
+    bool MatchesRemainingSegments(const FCompiledRule& CompiledRule, const TArray<FStringView>& Segments, int32 SegmentIndex, int32 GlobIndex) const;
+
+    TArray<FCompiledRule> Rules;
+    TArray<FTrieNode> Trie;
+};
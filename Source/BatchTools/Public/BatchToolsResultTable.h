@@ -0,0 +1,294 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+
+// Optimization methods
+enum class EOptimizationMethod : uint8
+{
+    LODBiasOnly,
+    ReimportOnly,
+    SmartAuto,
+    MaxInGameSize,
+    MeshLODs,
+    NaniteFallback,
+    AudioCompression,
+
+    Count
+};
+
+const TCHAR* LexToString(EOptimizationMethod Method);
+bool LexTryParseString(EOptimizationMethod& OutMethod, const TCHAR* Buffer);
+
+// Asset type of a result row
+enum class EBatchAssetKind : uint8
+{
+    Texture,
+    StaticMesh,
+    SoundWave,
+    Folder,
+
+    Count
+};
+
+// Why a texture was left unchanged; messages are only formatted for display
+enum class EOptimizationError : uint8
+{
+    None,
+    AlreadyAtTarget,
+    NoLODBias,
+    SourceFileMissing,
+    ReimportSimulated,
+    SkippedByPolicy,
+    LoadFailed,
+    NotATexture,
+    UnsavedChanges,
+    NoWorkerResult,
+    Cancelled,
+    SourceDecodeFailed,
+    TelemetryUnchanged,
+    WithinBudget,
+    AudioUnchanged,
+    StillOverBudget,
+    NoBudget,
+    CheckoutFailed,
+    OpenInEditor,
+    ReimportTrial,
+    SaveFailed,
+
+    Count
+};
+
+const TCHAR* LexToString(EOptimizationError Error);
+bool LexTryParseString(EOptimizationError& OutError, const TCHAR* Buffer);
+FString FormatOptimizationError(EOptimizationError Error, int32 Width = 0, int32 Height = 0, int32 TargetResolution = 0);
+
+// Result of optimizing a single texture, or a mesh, sound wave or budget folder when AssetKind says so
+struct FTextureOptimizationResult
+{
+    FName TextureName;
+    // Package of the asset, so rows can be matched back to assets that share a name; None for folder rows
+    FName PackageName;
+    EBatchAssetKind AssetKind = EBatchAssetKind::Texture;
+    int32 OriginalWidth = 0;
+    int32 OriginalHeight = 0;
+    int32 FinalWidth = 0;
+    int32 FinalHeight = 0;
+    // Requested target resolution; 0 for rows that are not sized against one
+    int32 TargetResolution = 0;
+    float VRAMSavedMB = 0.0f;
+    float FileSizeSavedMB = 0.0f;
+    // Savings come from a size model rather than measured output
+    bool bEstimated = false;
+    bool bSuccess = false;
+    bool bHadSourceFile = false;
+    EOptimizationMethod MethodUsed = EOptimizationMethod::LODBiasOnly;
+    EOptimizationError Error = EOptimizationError::None;
+
+    // Meshes only: LOD0 counts and exact resource size before and after the build
+    uint32 OriginalVertices = 0;
+    uint32 FinalVertices = 0;
+    uint32 OriginalIndices = 0;
+    uint32 FinalIndices = 0;
+    int64 OriginalBytes = 0;
+    int64 FinalBytes = 0;
+
+    // Sound waves only: effective sample rate and compression quality (1-100) before and after
+    uint32 OriginalSampleRate = 0;
+    uint32 FinalSampleRate = 0;
+    uint8 OriginalQuality = 0;
+    uint8 FinalQuality = 0;
+    // Resident audio memory saved; streamed waves only keep their first chunk resident
+    float MemorySavedMB = 0.0f;
+
+    // Folders only: target after headroom and parent constraints; OriginalBytes/FinalBytes hold the rollup
+    int64 BudgetBytes = 0;
+    bool bOverBudget = false;
+
+    FString GetErrorMessage() const { return FormatOptimizationError(Error, OriginalWidth, OriginalHeight, TargetResolution); }
+};
+
+// Batch-wide aggregates of a result table
+struct FTextureOptimizationTotals
+{
+    int32 NumRows = 0;
+    int32 NumSuccessful = 0;
+    int32 NumWithSource = 0;
+    int32 NumOverBudget = 0;
+    double VRAMSavedMB = 0.0;
+    double FileSizeSavedMB = 0.0;
+    // Sound wave rows only; audio memory is not part of VRAMSavedMB
+    double AudioMemorySavedMB = 0.0;
+    int32 MethodCounts[(int32)EOptimizationMethod::Count] = {};
+    int32 ErrorCounts[(int32)EOptimizationError::Count] = {};
+    int32 KindCounts[(int32)EBatchAssetKind::Count] = {};
+    int32 KindSuccessCounts[(int32)EBatchAssetKind::Count] = {};
+
+    int32 GetMethodCount(EOptimizationMethod Method) const { return MethodCounts[(int32)Method]; }
+    int32 GetErrorCount(EOptimizationError Error) const { return ErrorCounts[(int32)Error]; }
+    int32 GetKindCount(EBatchAssetKind Kind) const { return KindCounts[(int32)Kind]; }
+    int32 GetKindSuccessCount(EBatchAssetKind Kind) const { return KindSuccessCounts[(int32)Kind]; }
+};
+
+// Per-kind data of the rows that need it, sorted by row so texture rows carry none of it
+template <typename ValueType>
+struct TResultSideTable
+{
+    TArray<int32> Rows;
+    TArray<ValueType> Values;
+
+    const ValueType* Find(int32 Row) const
+    {
+        const int32 Index = Algo::BinarySearch(Rows, Row);
+        return Index != INDEX_NONE ? &Values[Index] : nullptr;
+    }
+
+    // Rows are added in ascending order, so the common case is a plain append
+    void Set(int32 Row, const ValueType& Value)
+    {
+        const int32 Index = Algo::LowerBound(Rows, Row);
+        if (Rows.IsValidIndex(Index) && Rows[Index] == Row)
+        {
+            Values[Index] = Value;
+            return;
+        }
+        Rows.Insert(Row, Index);
+        Values.Insert(Value, Index);
+    }
+
+    void Remove(int32 Row)
+    {
+        const int32 Index = Algo::BinarySearch(Rows, Row);
+        if (Index != INDEX_NONE)
+        {
+            Rows.RemoveAt(Index);
+            Values.RemoveAt(Index);
+        }
+    }
+
+    void Append(const TResultSideTable& Other, int32 RowOffset)
+    {
+        Rows.Reserve(Rows.Num() + Other.Rows.Num());
+        for (int32 Row : Other.Rows)
+            Rows.Add(Row + RowOffset);
+        Values.Append(Other.Values);
+    }
+
+    void Reset()
+    {
+        Rows.Reset();
+        Values.Reset();
+    }
+};
+
+// Column-oriented batch results, one row per asset. Texture data is stored in columns; mesh, sound
+// wave and folder data lives in side tables keyed by row. Pass by reference or move it between stages.
+class FTextureOptimizationResultTable
+{
+public:
+    int32 Num() const { return TextureNames.Num(); }
+    bool IsEmpty() const { return TextureNames.Num() == 0; }
+
+    void Reserve(int32 NumRows);
+    void Reset();
+    int32 Add(const FTextureOptimizationResult& Result);
+    void Append(const FTextureOptimizationResultTable& Other);
+    // Overwrites every column of an existing row
+    void Set(int32 Row, const FTextureOptimizationResult& Result);
+
+    // Row accessors
+    FTextureOptimizationResult GetRow(int32 Row) const;
+    FName GetTextureName(int32 Row) const { return TextureNames[Row]; }
+    FName GetPackageName(int32 Row) const { return PackageNames[Row]; }
+    int32 GetOriginalWidth(int32 Row) const { return OriginalWidths[Row]; }
+    int32 GetOriginalHeight(int32 Row) const { return OriginalHeights[Row]; }
+    int32 GetFinalWidth(int32 Row) const { return FinalWidths[Row]; }
+    int32 GetFinalHeight(int32 Row) const { return FinalHeights[Row]; }
+    int32 GetTargetResolution(int32 Row) const { return TargetResolutions[Row]; }
+    float GetVRAMSavedMB(int32 Row) const { return VRAMSavedMB[Row]; }
+    float GetFileSizeSavedMB(int32 Row) const { return FileSizeSavedMB[Row]; }
+    bool IsSuccess(int32 Row) const { return (Flags[Row] & RowFlag_Success) != 0; }
+    bool HadSourceFile(int32 Row) const { return (Flags[Row] & RowFlag_HadSource) != 0; }
+    bool IsOverBudget(int32 Row) const { return (Flags[Row] & RowFlag_OverBudget) != 0; }
+    bool IsEstimated(int32 Row) const { return (Flags[Row] & RowFlag_Estimated) != 0; }
+    EOptimizationMethod GetMethod(int32 Row) const { return Methods[Row]; }
+    EOptimizationError GetError(int32 Row) const { return Errors[Row]; }
+    FString GetErrorMessage(int32 Row) const { return FormatOptimizationError(Errors[Row], OriginalWidths[Row], OriginalHeights[Row], TargetResolutions[Row]); }
+    EBatchAssetKind GetAssetKind(int32 Row) const { return Kinds[Row]; }
+
+    // Per-kind accessors; 0 for rows of another kind
+    uint32 GetOriginalVertices(int32 Row) const;
+    uint32 GetFinalVertices(int32 Row) const;
+    uint32 GetOriginalIndices(int32 Row) const;
+    uint32 GetFinalIndices(int32 Row) const;
+    int64 GetOriginalBytes(int32 Row) const;
+    int64 GetFinalBytes(int32 Row) const;
+    uint32 GetOriginalSampleRate(int32 Row) const;
+    uint32 GetFinalSampleRate(int32 Row) const;
+    uint8 GetOriginalQuality(int32 Row) const;
+    uint8 GetFinalQuality(int32 Row) const;
+    float GetMemorySavedMB(int32 Row) const;
+    int64 GetBudgetBytes(int32 Row) const;
+
+    // One pass per column over the whole batch
+    FTextureOptimizationTotals ComputeTotals() const;
+
+private:
+    enum ERowFlags : uint8
+    {
+        RowFlag_Success = 1 << 0,
+        RowFlag_HadSource = 1 << 1,
+        RowFlag_OverBudget = 1 << 2,
+        RowFlag_Estimated = 1 << 3
+    };
+
+    static uint8 MakeFlags(const FTextureOptimizationResult& Result);
+
+    struct FMeshRowData
+    {
+        uint32 OriginalVertices = 0;
+        uint32 FinalVertices = 0;
+        uint32 OriginalIndices = 0;
+        uint32 FinalIndices = 0;
+        int64 OriginalBytes = 0;
+        int64 FinalBytes = 0;
+    };
+
+    struct FSoundRowData
+    {
+        uint32 OriginalSampleRate = 0;
+        uint32 FinalSampleRate = 0;
+        uint8 OriginalQuality = 0;
+        uint8 FinalQuality = 0;
+        int64 OriginalBytes = 0;
+        int64 FinalBytes = 0;
+        float MemorySavedMB = 0.0f;
+    };
+
+    struct FFolderRowData
+    {
+        int64 OriginalBytes = 0;
+        int64 FinalBytes = 0;
+        int64 BudgetBytes = 0;
+    };
+
+    void SetKindData(int32 Row, const FTextureOptimizationResult& Result);
+
+    TArray<FName> TextureNames;
+    TArray<FName> PackageNames;
+    TArray<int32> OriginalWidths;
+    TArray<int32> OriginalHeights;
+    TArray<int32> FinalWidths;
+    TArray<int32> FinalHeights;
+    TArray<int32> TargetResolutions;
+    TArray<float> VRAMSavedMB;
+    TArray<float> FileSizeSavedMB;
+    TArray<uint8> Flags;
+    TArray<EOptimizationMethod> Methods;
+    TArray<EOptimizationError> Errors;
+    TArray<EBatchAssetKind> Kinds;
+
+    TResultSideTable<FMeshRowData> MeshData;
+    TResultSideTable<FSoundRowData> SoundData;
+    TResultSideTable<FFolderRowData> FolderData;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "BatchToolsModule.h"
+
+// Sharding settings from the [BatchTools.Sharding] section of DefaultBatchTools.ini
+struct FBatchToolsShardSettings
+{
+    // Worker editor processes to launch, 0 or 1 runs the batch in this process
+    int32 NumWorkers = 0;
+    // Smaller batches are not worth the worker startup time
+    int32 MinAssetsForSharding = 500;
+    // Shards per worker; more shards even out uneven texture sizes
+    int32 ShardsPerWorker = 8;
+
+    static FBatchToolsShardSettings Load();
+};
+
+// Splits a batch into shards processed by headless child editors (-run=BatchTools -ShardQueue=...).
+// Shards sit in a queue directory and idle workers claim the next one with an atomic rename,
+// so fast workers steal the remaining work from slow ones.
+class FBatchToolsShardCoordinator
+{
+public:
+    // Runs the batch across NumWorkers child processes and merges their results
+    static FTextureOptimizationResultTable Run(const TArray<FAssetData>& Assets, EOptimizationMethod Method, int32 TargetResolution, int32 NumWorkers, int32 ShardsPerWorker);
+
+    // Worker side: claims shards from QueueDirectory until none are left, returns the number processed
+    static int32 RunWorker(FBatchToolsModule& Module, const FString& QueueDirectory, EOptimizationMethod Method, int32 TargetResolution);
+};
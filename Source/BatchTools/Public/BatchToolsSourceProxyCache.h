@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+
+// Forward declarations
+class UTexture;
+struct FImage;
+
+// Proxy cache settings from the [BatchTools.SourceProxy] section of DefaultBatchTools.ini
+struct FBatchToolsSourceProxySettings
+{
+    bool bEnabled = true;
+    // Least recently used proxies are deleted above this size
+    int32 MaxCacheSizeMB = 8192;
+    // The pyramid stops once the largest dimension is at or below this
+    int32 MinLevelSize = 64;
+    // Replace the texture source with the resampled image (undoable); off keeps reimport trials calculate-only
+    bool bWriteSource = false;
+
+    static FBatchToolsSourceProxySettings Load();
+};
+
+// Decoded source files stored as losslessly compressed mip pyramids under
+// Saved/BatchTools/SourceProxies, one file per source content hash. Reimport trials at different
+// budgets resample from the nearest larger level instead of decoding the full source again.
+class FBatchToolsSourceProxyCache
+{
+public:
+    FBatchToolsSourceProxyCache(const FBatchToolsSourceProxySettings& InSettings);
+
+    // Size of the texture's source file, only known once its proxy is cached
+    bool FindSourceSize(const UTexture* Texture, FIntPoint& OutSize);
+
+    // Source image resampled to exactly Width x Height; builds the proxy on first use
+    bool Resample(const UTexture* Texture, int32 Width, int32 Height, FImage& OutImage);
+
+    const FBatchToolsSourceProxySettings& GetSettings() const { return Settings; }
+    int32 GetNumHits() const { return NumHits; }
+    int32 GetNumMisses() const { return NumMisses; }
+
+    static FString GetCacheDirectory();
+
+private:
+    struct FSourceKey
+    {
+        FString Filename;
+        FMD5Hash Hash;
+    };
+
+    struct FLevelInfo
+    {
+        int32 Width = 0;
+        int32 Height = 0;
+        int64 Offset = 0;
+        int64 CompressedSize = 0;
+        int64 UncompressedSize = 0;
+    };
+
+    struct FProxyHeader
+    {
+        uint8 Format = 0;
+        uint8 GammaSpace = 0;
+        TArray<FLevelInfo> Levels;
+    };
+
+    bool ResolveSource(const UTexture* Texture, FSourceKey& OutKey);
+    FString GetProxyFilename(const FMD5Hash& Hash) const;
+
+    // Decodes the source, writes its pyramid and returns the levels in memory
+    bool BuildProxy(const FSourceKey& Key, TArray<FImage>& OutLevels);
+
+    // Both read through a memory-mapped view of the proxy file; only the requested level is paged in
+    bool ReadHeader(const FString& ProxyFilename, FProxyHeader& OutHeader) const;
+    bool ReadLevel(const FString& ProxyFilename, const FProxyHeader& Header, int32 LevelIndex, FImage& OutLevel) const;
+
+    // Smallest level that still covers Width x Height
+    static int32 ChooseLevel(const TArray<FIntPoint>& LevelSizes, int32 Width, int32 Height);
+
+    void TrimCache() const;
+
+    FBatchToolsSourceProxySettings Settings;
+
+    // Hashes computed for sources edited after import, keyed by filename and timestamp
+    TMap<FString, TPair<FDateTime, FMD5Hash>> ComputedHashes;
+
+    int32 NumHits = 0;
+    int32 NumMisses = 0;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declarations
+class UTexture;
+struct FAssetData;
+class FTextureOptimizationResultTable;
+
+// One bucket of the on-screen size distribution: textures are seen at ScreenSizePixels for Weight of the time.
+// Read from the [BatchTools.Streaming] section of DefaultBatchTools.ini, e.g.
+//   +ScreenSizes=(ScreenSizePixels=512, Weight=0.2)
+struct FStreamingScreenSizeBucket
+{
+    int32 ScreenSizePixels = 512;
+    float Weight = 1.0f;
+
+    static bool Parse(const FString& BucketText, FStreamingScreenSizeBucket& OutBucket);
+};
+
+// Simulation settings
+struct FStreamingSimulationSettings
+{
+    float PoolSizeMB = 1000.0f;
+    float VirtualTexturePoolSizeMB = 256.0f;
+    TArray<FStreamingScreenSizeBucket> ScreenSizeDistribution;
+
+    // Pool sizes from r.Streaming.PoolSize / r.VT.PoolSizeScale; the screen-size distribution comes from
+    // [BatchTools.Streaming], with a built-in one when the project sets none
+    static FStreamingSimulationSettings FromEngineDefaults();
+};
+
+// Mip chain of a single texture as seen by the streamer, mip 0 first
+struct FStreamingSimulationTexture
+{
+    int32 Width = 0;
+    int32 Height = 0;
+    TArray<int64> MipSizes;
+    // Existing LOD bias; the streamer never loads the top LODBias mips
+    int32 LODBias = 0;
+    bool bVirtualTexture = false;
+    bool bNeverStream = false;
+};
+
+// Estimated pool residency before and after a batch
+struct FStreamingSimulationReport
+{
+    int32 NumTextures = 0;
+    float PoolSizeMB = 0.0f;
+    float VirtualTexturePoolSizeMB = 0.0f;
+    float BeforeResidentMB = 0.0f;
+    float AfterResidentMB = 0.0f;
+    float BeforeVirtualTextureResidentMB = 0.0f;
+    float AfterVirtualTextureResidentMB = 0.0f;
+
+    float GetBeforeOvercommitMB() const { return FMath::Max(0.0f, BeforeResidentMB - PoolSizeMB); }
+    float GetAfterOvercommitMB() const { return FMath::Max(0.0f, AfterResidentMB - PoolSizeMB); }
+    float GetBeforeVirtualTextureOvercommitMB() const { return FMath::Max(0.0f, BeforeVirtualTextureResidentMB - VirtualTexturePoolSizeMB); }
+    float GetAfterVirtualTextureOvercommitMB() const { return FMath::Max(0.0f, AfterVirtualTextureResidentMB - VirtualTexturePoolSizeMB); }
+};
+
+// Offline texture streaming pool / VT pool simulator
+class FBatchToolsStreamingSimulator
+{
+public:
+    // Captures the current mip chain of a texture (call before optimizing it)
+    static FStreamingSimulationTexture GatherTexture(UTexture* Texture);
+
+    // Same as GatherTexture from Asset Registry tags, for textures that are not loaded
+    static FStreamingSimulationTexture GatherTextureFromTags(const FAssetData& Asset);
+
+    // Builds a mip chain for the given size with a fixed cost per pixel
+    static TArray<int64> BuildMipSizes(int32 Width, int32 Height, double BytesPerPixel);
+
+    // Mip chain of the texture once it is optimized to the final size
+    static TArray<int64> GetOptimizedMipSizes(const FStreamingSimulationTexture& Texture, int32 FinalWidth, int32 FinalHeight);
+
+    // Expected resident bytes of a mip chain over the screen-size distribution
+    static double CalculateExpectedResidentBytes(const TArray<int64>& MipSizes, int32 Width, int32 Height, const FStreamingSimulationTexture& Texture, const FStreamingSimulationSettings& Settings);
+
+    // Simulates the whole batch; Textures has one entry per result row
+    static FStreamingSimulationReport Simulate(const TArray<FStreamingSimulationTexture>& Textures, const FTextureOptimizationResultTable& Results, const FStreamingSimulationSettings& Settings);
+};
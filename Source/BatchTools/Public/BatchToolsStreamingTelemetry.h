@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+// Telemetry settings from the [BatchTools.Telemetry] section of DefaultBatchTools.ini
+struct FBatchToolsTelemetrySettings
+{
+    // Mips kept above the largest size any run requested
+    int32 SafetyMarginMips = 1;
+    // Textures seen in fewer runs keep their current bias
+    int32 MinRuns = 1;
+    // Upper bound on the bias set from telemetry
+    int32 MaxLODBias = 4;
+
+    static FBatchToolsTelemetrySettings Load();
+};
+
+// Largest size one texture was requested at, over all ingested runs
+struct FStreamingTelemetryEntry
+{
+    int32 MaxRequestedWidth = 0;
+    int32 MaxRequestedHeight = 0;
+    int32 NumRuns = 0;
+};
+
+// Aggregates streaming captures recorded in playtests (ListTextures CSV dumps or any CSV with a
+// texture name column and a "W x H" requested/current size column). Each file counts as one run.
+class FBatchToolsStreamingTelemetry
+{
+public:
+    // Parses the files in parallel; each file is read line by line, never loaded whole
+    void IngestFiles(const TArray<FString>& Filenames);
+
+    // Expands directories to the *.csv files inside them
+    static TArray<FString> FindCaptureFiles(const TArray<FString>& FilesOrDirectories);
+
+    // One entry per asset, or null. Rows recorded with a bare texture name only match when the
+    // name is unique in the batch.
+    TArray<const FStreamingTelemetryEntry*> MatchAssets(const TArray<FAssetData>& Assets) const;
+
+    // Bias that drops the mips no run requested, never lower than the current bias
+    static int32 CalculateLODBias(int32 Width, int32 Height, int32 CurrentLODBias, const FStreamingTelemetryEntry& Entry, const FBatchToolsTelemetrySettings& Settings);
+
+    int32 NumRuns() const { return NumFiles; }
+    int32 NumTextures() const { return EntriesByPackage.Num() + EntriesByName.Num(); }
+    int64 NumRows() const { return NumRowsParsed; }
+
+private:
+    struct FParsedFile
+    {
+        TMap<FName, FStreamingTelemetryEntry> ByPackage;
+        TMap<FName, FStreamingTelemetryEntry> ByName;
+        int64 NumRows = 0;
+        bool bHasHeader = false;
+    };
+
+    static void ParseFile(const FString& Filename, FParsedFile& OutFile);
+    static void MergeRun(const TMap<FName, FStreamingTelemetryEntry>& Run, TMap<FName, FStreamingTelemetryEntry>& Into);
+
+    // Keyed by package name for rows with a full object path, by asset name otherwise
+    TMap<FName, FStreamingTelemetryEntry> EntriesByPackage;
+    TMap<FName, FStreamingTelemetryEntry> EntriesByName;
+    int32 NumFiles = 0;
+    int64 NumRowsParsed = 0;
+};
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "Containers/Ticker.h"
+#include "AssetRegistry/AssetData.h"
+#include "BatchToolsModule.h"
+#include "BatchToolsPolicy.h"
+#include "BatchToolsSubsystem.generated.h"
+
+// Scripting mirror of EOptimizationMethod
+UENUM(BlueprintType)
+enum class EBatchToolsOptimizationMethod : uint8
+{
+    LODBias,
+    Reimport,
+    Smart,
+    MaxSize
+};
+
+UENUM(BlueprintType)
+enum class EBatchToolsJobState : uint8
+{
+    Invalid,
+    Running,
+    Completed,
+    Cancelled
+};
+
+// Cost of one texture, read from the Asset Registry without loading it
+USTRUCT(BlueprintType)
+struct FBatchToolsTextureAnalysis
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    FString AssetPath;
+
+    // False when the path does not name a texture
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    bool bFound = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 Width = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 Height = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    FName Format;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    FName LODGroup;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 LODBias = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    bool bHasSourceFile = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    float ResidentMB = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    bool bSkippedByPolicy = false;
+
+    // 0 when no policy rule caps the size
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 PolicyMaxSize = 0;
+};
+
+// What Apply would do to one texture
+USTRUCT(BlueprintType)
+struct FBatchToolsTexturePlan
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    FString AssetPath;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    bool bWillChange = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    EBatchToolsOptimizationMethod Method = EBatchToolsOptimizationMethod::Smart;
+
+    // Target after the policy MaxSize cap
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 TargetResolution = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 PlannedWidth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 PlannedHeight = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    float VRAMSavedMB = 0.0f;
+
+    // Why the texture is left alone
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    FString Reason;
+};
+
+// Outcome of applying the optimization to one texture
+USTRUCT(BlueprintType)
+struct FBatchToolsTextureResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    FString AssetPath;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    bool bSuccess = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    EBatchToolsOptimizationMethod Method = EBatchToolsOptimizationMethod::Smart;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 OriginalWidth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 OriginalHeight = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 FinalWidth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 FinalHeight = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    float VRAMSavedMB = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    float FileSizeSavedMB = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    FString ErrorMessage;
+};
+
+USTRUCT(BlueprintType)
+struct FBatchToolsJobHandle
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "BatchTools")
+    int32 Id = INDEX_NONE;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FBatchToolsJobCompleted, FBatchToolsJobHandle, Job);
+
+/**
+ * Batched texture optimization for Python and Blueprint pipelines. Each call takes the whole
+ * batch of asset paths ("/Game/Env/T_Rock" or "/Game/Env/T_Rock.T_Rock"), so a scripted pass is
+ * one native call instead of a round-trip per texture.
+ *
+ *   batch_tools = unreal.get_editor_subsystem(unreal.BatchToolsSubsystem)
+ *   paths = batch_tools.find_textures(["/Game/Env"])
+ *   plans = batch_tools.plan_textures(paths, unreal.BatchToolsOptimizationMethod.SMART, 1024)
+ *   results = batch_tools.apply_textures(paths, unreal.BatchToolsOptimizationMethod.SMART, 1024, True)
+ */
+UCLASS()
+class UBatchToolsSubsystem : public UEditorSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    // Keeps the textures of running jobs alive until their batch is finished
+    static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+    // Object paths of every texture under the folders
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    TArray<FString> FindTextures(const TArray<FString>& Folders);
+
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    TArray<FBatchToolsTextureAnalysis> AnalyzeTextures(const TArray<FString>& AssetPaths);
+
+    // Dry run of ApplyTextures from Asset Registry data
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    TArray<FBatchToolsTexturePlan> PlanTextures(const TArray<FString>& AssetPaths, EBatchToolsOptimizationMethod Method, int32 TargetResolution);
+
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    TArray<FBatchToolsTextureResult> ApplyTextures(const TArray<FString>& AssetPaths, EBatchToolsOptimizationMethod Method, int32 TargetResolution, bool bSave);
+
+    // Applies the batch a slice per editor tick; poll the handle or bind OnJobCompleted
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    FBatchToolsJobHandle ApplyTexturesAsync(const TArray<FString>& AssetPaths, EBatchToolsOptimizationMethod Method, int32 TargetResolution, bool bSave, float TimeBudgetMs = 10.0f);
+
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    EBatchToolsJobState GetJobState(FBatchToolsJobHandle Job) const;
+
+    // Fraction of the batch processed, 0 to 1
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    float GetJobProgress(FBatchToolsJobHandle Job) const;
+
+    // Results of the textures processed so far
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    TArray<FBatchToolsTextureResult> GetJobResults(FBatchToolsJobHandle Job) const;
+
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    void CancelJob(FBatchToolsJobHandle Job);
+
+    // Frees a finished job's results
+    UFUNCTION(BlueprintCallable, Category = "BatchTools")
+    void ReleaseJob(FBatchToolsJobHandle Job);
+
+    UPROPERTY(BlueprintAssignable, Category = "BatchTools")
+    FBatchToolsJobCompleted OnJobCompleted;
+
+private:
+    struct FApplyJob
+    {
+        TArray<FString> AssetPaths;
+        TArray<FAssetData> Assets;
+        TArray<FTexturePolicyDecision> Decisions;
+        EOptimizationMethod Method = EOptimizationMethod::SmartAuto;
+        int32 TargetResolution = 512;
+        bool bSave = false;
+        double TimeBudgetSeconds = 0.01;
+
+        int32 NextIndex = 0;
+        TArray<FBatchToolsTextureResult> Results;
+        // Batch row of each result, INDEX_NONE when the texture was not processed
+        TArray<int32> BatchRows;
+        FTextureBatch Batch;
+        EBatchToolsJobState State = EBatchToolsJobState::Running;
+    };
+
+    TArray<FAssetData> ResolveAssetPaths(const TArray<FString>& AssetPaths) const;
+    void InitJob(FApplyJob& Job, const TArray<FString>& AssetPaths, EBatchToolsOptimizationMethod Method, int32 TargetResolution, bool bSave) const;
+    void ApplyNext(FApplyJob& Job);
+    void FinishJob(FApplyJob& Job);
+    bool Tick(float DeltaTime);
+
+    TMap<int32, FApplyJob> Jobs;
+    int32 NextJobId = 0;
+    FTSTicker::FDelegateHandle TickerHandle;
+};
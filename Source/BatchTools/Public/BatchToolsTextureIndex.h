@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
+
+class IAssetRegistry;
+
+// Aggregate row of a group-by query
+struct FTextureIndexGroup
+{
+    FName Key;
+    int32 Count = 0;
+    int64 ResidentBytes = 0;
+};
+
+// Histogram bucket keyed by the largest dimension
+struct FTextureIndexHistogramBucket
+{
+    int32 MaxDimension = 0;
+    int32 Count = 0;
+    int64 ResidentBytes = 0;
+};
+
+// Cost of one texture as read from its Asset Registry tags
+struct FTextureIndexEntry
+{
+    int32 Width = 0;
+    int32 Height = 0;
+    FName Format;
+    FName LODGroup;
+    int32 LODBias = 0;
+    int64 ResidentBytes = 0;
+    bool bHasSource = false;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTexturePackagesChanged, const TArray<FName>& /*PackageNames*/);
+
+// Read-only, column-oriented snapshot of every texture's cost, built from Asset Registry tags
+// without loading any texture. Persisted to Saved/BatchTools/TextureIndex.btidx; while listening,
+// changes are written at most every ten seconds and once more on destruction.
+class FBatchToolsTextureIndex
+{
+public:
+    FBatchToolsTextureIndex();
+    ~FBatchToolsTextureIndex();
+
+    // Full parallel rebuild of every texture under RootPath
+    void Build(const FString& RootPath = TEXT("/Game"));
+
+    // Adds/removes rows to match the Asset Registry and flushes pending change events
+    void Refresh();
+
+    bool Load();
+    bool Save();
+    static FString GetSnapshotFilename();
+
+    // Keeps the snapshot current from Asset Registry change events
+    void StartListening();
+    void StopListening();
+
+    int32 Num() const { return PackageNames.Num(); }
+    bool IsEmpty() const { return PackageNames.Num() == 0; }
+
+    // Row accessors
+    FName GetPackageName(int32 Row) const { return PackageNames[Row]; }
+    FName GetAssetName(int32 Row) const { return AssetNames[Row]; }
+    FName GetFolder(int32 Row) const { return Folders[Row]; }
+    FName GetFormat(int32 Row) const { return Formats[Row]; }
+    FName GetLODGroup(int32 Row) const { return LODGroups[Row]; }
+    int32 GetWidth(int32 Row) const { return Widths[Row]; }
+    int32 GetHeight(int32 Row) const { return Heights[Row]; }
+    int64 GetResidentBytes(int32 Row) const { return ResidentBytes[Row]; }
+    int32 GetLODBias(int32 Row) const { return LODBiases[Row]; }
+    bool HasSourceFile(int32 Row) const { return HasSource[Row] != 0; }
+    int32 GetReferencerCount(int32 Row) const { return ReferencerCounts[Row]; }
+    int32 FindRow(FName PackageName) const;
+
+    // Queries
+    TArray<int32> QueryTopN(int32 N) const;
+    TArray<FTextureIndexGroup> QueryGroupByFolder() const;
+    TArray<FTextureIndexGroup> QueryGroupByLODGroup() const;
+    TArray<FTextureIndexHistogramBucket> QueryHistogram() const;
+
+    // Fired on the game thread whenever rows change
+    FSimpleMulticastDelegate& OnChanged() { return ChangedDelegate; }
+
+    // Fired on the game thread with the packages updated or removed by registry events
+    FOnTexturePackagesChanged& OnPackagesChanged() { return PackagesChangedDelegate; }
+
+    // Reads one texture's cost without loading it
+    static FTextureIndexEntry ReadAssetTags(const FAssetData& Asset);
+
+    // Estimated resident bytes of the streamed mip chain, the same cost model as the streaming simulator
+    static int64 EstimateResidentBytes(int32 Width, int32 Height, FName Format, int32 LODBias);
+
+    // Bytes of each mip of a full chain in the named pixel format, mip 0 first
+    static TArray<int64> EstimateMipSizes(int32 Width, int32 Height, FName Format);
+
+private:
+    void ResetColumns();
+    void UpdateRows(const TArray<FAssetData>& Assets);
+    void RemoveRow(FName PackageName);
+    void ComputeRow(int32 Row, const FAssetData& Asset, const IAssetRegistry& AssetRegistry);
+    TArray<FTextureIndexGroup> GroupBy(const TArray<FName>& KeyColumn) const;
+
+    void OnAssetAdded(const FAssetData& Asset);
+    void OnAssetRemoved(const FAssetData& Asset);
+    void OnAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath);
+    void OnAssetUpdated(const FAssetData& Asset);
+    bool IsIndexedTexture(const FAssetData& Asset) const;
+    bool Tick(float DeltaTime);
+
+    // Columns, one entry per texture
+    TArray<FName> PackageNames;
+    TArray<FName> AssetNames;
+    TArray<FName> Folders;
+    TArray<FName> Formats;
+    TArray<FName> LODGroups;
+    TArray<uint16> Widths;
+    TArray<uint16> Heights;
+    TArray<int64> ResidentBytes;
+    TArray<uint8> LODBiases;
+    TArray<uint8> HasSource;
+    TArray<int32> ReferencerCounts;
+
+    TMap<FName, int32> RowByPackage;
+    FString IndexedRootPath = TEXT("/Game");
+
+    // Pending Asset Registry events, flushed on tick
+    TSet<FName> DirtyPackages;
+    TSet<FName> RemovedPackages;
+    bool bSnapshotDirty = false;
+    double LastSaveTime = 0.0;
+
+    FSimpleMulticastDelegate ChangedDelegate;
+    FOnTexturePackagesChanged PackagesChangedDelegate;
+    FTSTicker::FDelegateHandle TickerHandle;
+    bool bListening = false;
+};